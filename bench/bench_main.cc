@@ -0,0 +1,99 @@
+#include <fmt/format.h>
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "bench/benchmark.hh"
+
+namespace {
+
+// Arguments: an optional filter, which only runs benchmarks whose name
+// contains it, and --csv or --json for machine readable results.
+struct Arguments {
+  std::string_view filter;
+  enum class Format { Table, Csv, Json } format = Format::Table;
+};
+
+auto parseArguments(int argc, char* argv[]) -> Arguments {
+  Arguments arguments;
+  for (int idx = 1; idx < argc; ++idx) {
+    const std::string_view argument{argv[idx]};  // NOLINT
+    if (argument == "--csv") {
+      arguments.format = Arguments::Format::Csv;
+    } else if (argument == "--json") {
+      arguments.format = Arguments::Format::Json;
+    } else {
+      arguments.filter = argument;
+    }
+  }
+  return arguments;
+}
+
+// `value` with `decimals` decimals, or `missing` if there is none.
+auto formatOptional(std::optional<double> value, int decimals,
+                    std::string_view missing) -> std::string {
+  if (!value) return std::string{missing};
+  return fmt::format("{:.{}f}", *value, decimals);
+}
+
+// Benchmarks that report no bytes or no nodes have empty CSV fields and
+// null in JSON for mb_per_second and ns_per_node, and "-" in the table.
+void printResult(Arguments::Format format, std::string_view name,
+                 const bench::State& state, bool first) {
+  auto megabytes = state.bytesPerSecond();
+  if (megabytes) *megabytes /= 1e6;
+  const auto ns_per_node = state.nanosecondsPerNode();
+  switch (format) {
+    case Arguments::Format::Table:
+      fmt::print("{:<44} {:>10} MB/s {:>14.0f} {}/s", name,
+                 formatOptional(megabytes, 1, "-"), state.itemsPerSecond(),
+                 state.unit());
+      if (ns_per_node) fmt::print(" {:>8.2f} ns/node", *ns_per_node);
+      fmt::print("\n");
+      break;
+    case Arguments::Format::Csv:
+      fmt::print("{},{},{:.6f},{},{:.3f},{},{}\n", name, state.iterations(),
+                 state.seconds(), formatOptional(megabytes, 3, ""),
+                 state.itemsPerSecond(), state.unit(),
+                 formatOptional(ns_per_node, 4, ""));
+      break;
+    case Arguments::Format::Json:
+      fmt::print(
+          R"({}  {{"name": "{}", "iterations": {}, "seconds": {:.6f}, )"
+          R"("mb_per_second": {}, "items_per_second": {:.3f}, )"
+          R"("unit": "{}", "ns_per_node": {}}})",
+          first ? "" : ",\n", name, state.iterations(), state.seconds(),
+          formatOptional(megabytes, 3, "null"), state.itemsPerSecond(),
+          state.unit(), formatOptional(ns_per_node, 4, "null"));
+      break;
+  }
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  using namespace std::chrono_literals;
+
+  const auto arguments = parseArguments(argc, argv);
+  if (arguments.format == Arguments::Format::Csv)
+    fmt::print(
+        "name,iterations,seconds,mb_per_second,items_per_second,unit,"
+        "ns_per_node\n");
+  if (arguments.format == Arguments::Format::Json) fmt::print("[\n");
+
+  bool first = true;
+  for (const auto& benchmark : bench::registry()) {
+    if (benchmark.name.find(arguments.filter) == std::string_view::npos)
+      continue;
+
+    bench::State state{500ms};
+    benchmark.body(state);
+    printResult(arguments.format, benchmark.name, state, first);
+    first = false;
+  }
+
+  if (arguments.format == Arguments::Format::Json) fmt::print("\n]\n");
+  return 0;
+}
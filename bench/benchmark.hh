@@ -0,0 +1,118 @@
+#ifndef BENCHMARK_HH
+#define BENCHMARK_HH
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+//
+// Minimal benchmark harness for json-bench.
+//
+// Benchmarks register themselves through the BENCHMARK() macro and receive a
+// bench::State. The body prepares its input, reports how many bytes, items
+// and document nodes a single iteration processes and then hands the code
+// under test to State::run(), which repeats it until a minimum amount of
+// time has passed.
+//
+
+namespace bench {
+
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  // NOLINTNEXTLINE(hicpp-no-assembler): Keeps the optimizer honest.
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class State {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit State(std::chrono::nanoseconds min_time) : min_time_{min_time} {}
+
+  void setBytesProcessed(size_t bytes) { bytes_ = bytes; }
+
+  void setItemsProcessed(size_t items, std::string_view unit) {
+    items_ = items;
+    unit_ = unit;
+  }
+
+  // Values, names and containers, as counted by the tape.
+  void setNodesProcessed(size_t nodes) { nodes_ = nodes; }
+
+  template <typename F>
+  void run(F&& body) {
+    body();  // Warm up caches and any lazily initialized state
+
+    size_t batch = 1;
+    iterations_ = 0;
+    elapsed_ = {};
+    while (elapsed_ < min_time_) {
+      const auto start = Clock::now();
+      for (size_t i = 0; i != batch; ++i) body();
+      elapsed_ += Clock::now() - start;
+      iterations_ += batch;
+      batch *= 2;
+    }
+  }
+
+  [[nodiscard]] auto iterations() const -> size_t { return iterations_; }
+
+  [[nodiscard]] auto seconds() const -> double {
+    return std::chrono::duration<double>(elapsed_).count();
+  }
+
+  // Empty unless the benchmark reported its bytes.
+  [[nodiscard]] auto bytesPerSecond() const -> std::optional<double> {
+    if (bytes_ == 0) return std::nullopt;
+    return static_cast<double>(bytes_ * iterations_) / seconds();
+  }
+
+  [[nodiscard]] auto itemsPerSecond() const -> double {
+    return static_cast<double>(items_ * iterations_) / seconds();
+  }
+
+  // Empty unless the benchmark reported its nodes.
+  [[nodiscard]] auto nanosecondsPerNode() const -> std::optional<double> {
+    if (nodes_ == 0) return std::nullopt;
+    return seconds() * 1e9 / static_cast<double>(nodes_ * iterations_);
+  }
+
+  [[nodiscard]] auto unit() const -> std::string_view { return unit_; }
+
+ private:
+  std::chrono::nanoseconds min_time_;
+  std::chrono::nanoseconds elapsed_{};
+  size_t iterations_{};
+  size_t bytes_{};
+  size_t items_{1};
+  size_t nodes_{};
+  std::string_view unit_{"iterations"};
+};
+
+struct Benchmark {
+  std::string_view name;
+  void (*body)(State&);
+};
+
+inline auto registry() -> std::vector<Benchmark>& {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct Registrar {
+  Registrar(std::string_view name, void (*body)(State&)) {
+    registry().push_back({name, body});
+  }
+};
+
+}  // namespace bench
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define BENCHMARK(name)                                       \
+  static void name(bench::State& state);                      \
+  static const bench::Registrar name##_registrar{#name, name}; \
+  static void name(bench::State& state)
+
+#endif  // BENCHMARK_HH
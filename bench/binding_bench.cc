@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/binding.hh"
+#include "json/json.hh"
+
+namespace {
+
+// The fields of a bench::mixedDocument() record, except for its tags.
+struct Record {
+  int64_t id{};
+  std::string name;
+  double ratio{};
+  bool active{};
+  std::optional<int64_t> parent;
+};
+
+auto records() -> const std::string& {
+  static const auto document = bench::mixedDocument(20000);
+  return document;
+}
+
+}  // namespace
+
+template <>
+struct json::Fields<Record> {
+  static constexpr auto list =
+      std::tuple{json::field("id", &Record::id),
+                 json::field("name", &Record::name),
+                 json::field("ratio", &Record::ratio),
+                 json::field("active", &Record::active),
+                 json::field("parent", &Record::parent)};
+};
+
+BENCHMARK(Binding_DecodeRecords) {
+  const auto& source = records();
+  state.setBytesProcessed(source.size());
+  std::vector<Record> decoded;
+  state.run([&] {
+    bench::doNotOptimize(json::decode(source, decoded));
+    bench::doNotOptimize(decoded.data());
+  });
+}
+
+// The way records were read before: parse, then copy field by field.
+BENCHMARK(Binding_ParseAndCopyRecords) {
+  const auto& source = records();
+  state.setBytesProcessed(source.size());
+  std::vector<Record> decoded;
+  state.run([&] {
+    const auto json = json::Json::parse(source);
+    decoded.clear();
+    for (const auto& value : json->begin()) {
+      auto& record = decoded.emplace_back();
+      record.id = value["id"].integer().value_or(0);
+      record.name = value["name"].string().value_or("");
+      record.ratio = value["ratio"].number().value_or(0);
+      record.active = value["active"].boolean().value_or(false);
+      record.parent = value["parent"].integer();
+    }
+    bench::doNotOptimize(decoded.data());
+  });
+}
+
+BENCHMARK(Binding_EncodeRecords) {
+  std::vector<Record> decoded;
+  static_cast<void>(json::decode(records(), decoded));
+  std::string out;
+  json::encodeInto(decoded, out);
+  state.setBytesProcessed(out.size());
+  state.run([&] {
+    out.clear();
+    json::encodeInto(decoded, out);
+    bench::doNotOptimize(out.data());
+  });
+}
@@ -0,0 +1,60 @@
+#include <string>
+
+#include "bench/benchmark.hh"
+#include "json/builder.hh"
+#include "json/json.hh"
+
+namespace {
+
+constexpr int Records = 10000;
+
+// The records of bench::mixedDocument(), built value by value.
+void buildRecords(json::Builder& builder) {
+  builder.beginArray();
+  for (int i = 0; i != Records; ++i) {
+    builder.beginObject();
+    builder.add("id", i * 7919);
+    builder.add("name", "item" + std::to_string(i));
+    builder.add("ratio", -0.25e-3);
+    builder.add("active", true);
+    builder.add("parent", nullptr);
+    builder.beginArray("tags");
+    builder.add("alpha");
+    builder.add("beta");
+    builder.add(false);
+    builder.endArray();
+    builder.endObject();
+  }
+  builder.endArray();
+}
+
+// The same records formatted as text first, the way documents were put
+// together before there was a builder.
+auto formatRecords() -> std::string {
+  std::string source = "[";
+  for (int i = 0; i != Records; ++i) {
+    if (i != 0) source += ",";
+    source += R"({"id":)" + std::to_string(i * 7919) + R"(,"name":"item)" +
+              std::to_string(i) +
+              R"(","ratio":-0.25e-3,"active":true,"parent":null,)"
+              R"("tags":["alpha","beta",false]})";
+  }
+  source += "]";
+  return source;
+}
+
+}  // namespace
+
+BENCHMARK(Builder_BuildDocument) {
+  state.setItemsProcessed(Records, "records");
+  json::Builder builder;
+  state.run([&] {
+    buildRecords(builder);
+    bench::doNotOptimize(builder.finish());
+  });
+}
+
+BENCHMARK(Builder_FormatAndParseDocument) {
+  state.setItemsProcessed(Records, "records");
+  state.run([&] { bench::doNotOptimize(json::Json::parse(formatRecords())); });
+}
@@ -0,0 +1,119 @@
+#include <cstddef>
+#include <string_view>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json.hh"
+#include "json/parser.hh"
+#include "json/tokenizer.hh"
+
+//
+// Every stage of reading a document, timed on its own for each document of
+// the corpus: tokenizing, building the tape, the whole of Json::parse(), and
+// reading the result back by iteration and by name.
+//
+
+namespace {
+
+// Tape entries of `source`, which ns/node is relative to.
+auto countNodes(std::string_view source) -> size_t {
+  json::internal::Parser<uint32_t> parser;
+  static_cast<void>(parser.parse(source));
+  return parser.tape().entries.size();
+}
+
+void prepare(bench::State& state, const bench::Document& document) {
+  state.setBytesProcessed(document.source.size());
+  state.setItemsProcessed(1, "documents");
+  state.setNodesProcessed(countNodes(document.source));
+}
+
+void tokenize(bench::State& state, std::string_view name) {
+  const auto& document = bench::corpusDocument(name);
+  prepare(state, document);
+  state.run([&] {
+    std::string_view source = document.source;
+    while (!source.empty()) {
+      auto token = json::internal::Tokenizer::parse(source);
+      if (!token) break;
+      bench::doNotOptimize(*token);
+    }
+  });
+}
+
+// The tape alone, with the parser's buffers reused between runs.
+void buildTape(bench::State& state, std::string_view name) {
+  const auto& document = bench::corpusDocument(name);
+  prepare(state, document);
+  json::internal::Parser<uint32_t> parser;
+  state.run([&] {
+    parser.reset(parser.takeTape(), json::internal::StringStorage::Copy);
+    bench::doNotOptimize(parser.parse(document.source));
+  });
+}
+
+void parse(bench::State& state, std::string_view name) {
+  const auto& document = bench::corpusDocument(name);
+  prepare(state, document);
+  state.run([&] {
+    auto json = json::Json::parse(document.source);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+void visit(const json::Json::value_iterator& value) {
+  bench::doNotOptimize(value.number());
+  for (const auto& child : value) visit(child);
+}
+
+// Every value, depth first.
+void iterate(bench::State& state, std::string_view name) {
+  const auto& document = bench::corpusDocument(name);
+  prepare(state, document);
+  const auto json = json::Json::parse(document.source);
+  state.run([&] { visit(json->begin()); });
+}
+
+}  // namespace
+
+BENCHMARK(Corpus_TokenizeMixed) { tokenize(state, "Mixed"); }
+BENCHMARK(Corpus_TokenizeNumbers) { tokenize(state, "Numbers"); }
+BENCHMARK(Corpus_TokenizeStrings) { tokenize(state, "Strings"); }
+BENCHMARK(Corpus_TokenizeNested) { tokenize(state, "Nested"); }
+BENCHMARK(Corpus_TokenizeWideObject) { tokenize(state, "WideObject"); }
+BENCHMARK(Corpus_TokenizeLargeArray) { tokenize(state, "LargeArray"); }
+BENCHMARK(Corpus_TokenizePretty) { tokenize(state, "Pretty"); }
+
+BENCHMARK(Corpus_BuildTapeMixed) { buildTape(state, "Mixed"); }
+BENCHMARK(Corpus_BuildTapeNumbers) { buildTape(state, "Numbers"); }
+BENCHMARK(Corpus_BuildTapeStrings) { buildTape(state, "Strings"); }
+BENCHMARK(Corpus_BuildTapeNested) { buildTape(state, "Nested"); }
+BENCHMARK(Corpus_BuildTapeWideObject) { buildTape(state, "WideObject"); }
+BENCHMARK(Corpus_BuildTapeLargeArray) { buildTape(state, "LargeArray"); }
+BENCHMARK(Corpus_BuildTapePretty) { buildTape(state, "Pretty"); }
+
+BENCHMARK(Corpus_ParseMixed) { parse(state, "Mixed"); }
+BENCHMARK(Corpus_ParseNumbers) { parse(state, "Numbers"); }
+BENCHMARK(Corpus_ParseStrings) { parse(state, "Strings"); }
+BENCHMARK(Corpus_ParseNested) { parse(state, "Nested"); }
+BENCHMARK(Corpus_ParseWideObject) { parse(state, "WideObject"); }
+BENCHMARK(Corpus_ParseLargeArray) { parse(state, "LargeArray"); }
+BENCHMARK(Corpus_ParsePretty) { parse(state, "Pretty"); }
+
+BENCHMARK(Corpus_IterateMixed) { iterate(state, "Mixed"); }
+BENCHMARK(Corpus_IterateNested) { iterate(state, "Nested"); }
+BENCHMARK(Corpus_IterateWideObject) { iterate(state, "WideObject"); }
+BENCHMARK(Corpus_IterateLargeArray) { iterate(state, "LargeArray"); }
+
+// Two names per record, looked up by operator[].
+BENCHMARK(Corpus_LookupMixed) {
+  const auto& document = bench::corpusDocument("Mixed");
+  prepare(state, document);
+  const auto json = json::Json::parse(document.source);
+  state.run([&] {
+    for (const auto& record : json->begin()) {
+      bench::doNotOptimize(record["name"].string());
+      bench::doNotOptimize(record["tags"].size());
+    }
+  });
+}
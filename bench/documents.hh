@@ -0,0 +1,166 @@
+#ifndef DOCUMENTS_HH
+#define DOCUMENTS_HH
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+// An array of small records mixing all value types, roughly 80 bytes per
+// record.
+inline auto mixedDocument(int records) -> std::string {
+  std::string source = "[";
+  for (int i = 0; i != records; ++i) {
+    if (i != 0) source += ",\n  ";
+    source += R"({"id": )" + std::to_string(i * 7919) +
+              R"(, "name": "item)" + std::to_string(i) +
+              R"(", "ratio": -0.25e-3, "active": true, "parent": null,)" +
+              R"( "tags": ["alpha", "beta", false]})";
+  }
+  source += "]";
+  return source;
+}
+
+// `records` records like those of mixedDocument(), one per line.
+inline auto lineDocuments(int records) -> std::string {
+  std::string source;
+  for (int i = 0; i != records; ++i) {
+    source += R"({"id": )" + std::to_string(i * 7919) +
+              R"(, "name": "item)" + std::to_string(i) +
+              R"(", "ratio": -0.25e-3, "active": true, "parent": null,)" +
+              R"( "tags": ["alpha", "beta", false]})" + "\n";
+  }
+  return source;
+}
+
+// `depth` nested arrays around `leaves` numbers, so the node count stays the
+// same while the depth changes.
+inline auto deepDocument(int depth, int leaves) -> std::string {
+  std::string source(static_cast<size_t>(depth), '[');
+  for (int i = 0; i != leaves; ++i) {
+    if (i != 0) source += ",";
+    source += std::to_string(i);
+  }
+  source.append(static_cast<size_t>(depth), ']');
+  return source;
+}
+
+// One object with `members` numeric members named "member0", "member1", ...
+inline auto wideObject(int members) -> std::string {
+  std::string source = "{";
+  for (int i = 0; i != members; ++i) {
+    if (i != 0) source += ", ";
+    source += "\"member" + std::to_string(i) + "\": " + std::to_string(i);
+  }
+  source += "}";
+  return source;
+}
+
+// Telemetry samples: records of timestamps, counters and measurements, about
+// 110 bytes each and almost nothing but numbers.
+inline auto numberDocument(int records) -> std::string {
+  std::string source = "[";
+  for (int i = 0; i != records; ++i) {
+    if (i != 0) source += ",\n  ";
+    source += R"({"ts": )" + std::to_string(1700000000000 + i * 250) +
+              R"(, "cpu": 0.)" + std::to_string(1000 + i % 9000) +
+              R"(, "bytes": )" + std::to_string(i * 104729) +
+              R"(, "temp": -1)" + std::to_string(i % 10) + R"(.25e-1,)" +
+              R"( "samples": [)" + std::to_string(i % 97) + ", " +
+              std::to_string(i % 89) + ", " + std::to_string(i % 83) + "]}";
+  }
+  source += "]";
+  return source;
+}
+
+// Messages of mostly text: sentences, some with escape sequences and
+// multibyte characters, about 250 bytes per record.
+inline auto stringDocument(int records) -> std::string {
+  std::string source = "[";
+  for (int i = 0; i != records; ++i) {
+    if (i != 0) source += ",\n  ";
+    source += R"({"from": "user)" + std::to_string(i % 1000) +
+              R"(@example.com", "subject": "Re: quarterly report #)" +
+              std::to_string(i) +
+              R"(", "body": "Thanks for the numbers. The \"draft\" is in)"
+              R"( the shared folder;\nplease review sections 2\u20133 before)"
+              R"( Friday. Grüße, café ☕", "labels": ["inbox", "work"]})";
+  }
+  source += "]";
+  return source;
+}
+
+// One flat array of `values` scalars of every type.
+inline auto largeArray(int values) -> std::string {
+  std::string source = "[";
+  for (int i = 0; i != values; ++i) {
+    if (i != 0) source += ",";
+    switch (i % 4) {
+      case 0:
+        source += std::to_string(i);
+        break;
+      case 1:
+        source += std::to_string(i) + ".5";
+        break;
+      case 2:
+        source += "\"v" + std::to_string(i) + "\"";
+        break;
+      default:
+        source += i % 8 == 3 ? "true" : "null";
+        break;
+    }
+  }
+  source += "]";
+  return source;
+}
+
+// The records of mixedDocument(), pretty printed with an indent of 4, so
+// that about half of the input is whitespace.
+inline auto prettyDocument(int records) -> std::string {
+  std::string source = "[\n";
+  for (int i = 0; i != records; ++i) {
+    if (i != 0) source += ",\n";
+    source += "    {\n        \"id\": " + std::to_string(i * 7919) +
+              ",\n        \"name\": \"item" + std::to_string(i) +
+              "\",\n        \"ratio\": -0.25e-3,\n        \"active\": true,"
+              "\n        \"parent\": null,\n        \"tags\": [\n"
+              "            \"alpha\",\n            \"beta\",\n"
+              "            false\n        ]\n    }";
+  }
+  source += "\n]";
+  return source;
+}
+
+struct Document {
+  std::string_view name;
+  std::string source;
+};
+
+// Documents of a few MB each, one per kind of input the parser has to be
+// fast on. Generated the same way on every run, so results of different
+// builds compare.
+inline auto corpus() -> const std::vector<Document>& {
+  static const std::vector<Document> documents{
+      {"Mixed", mixedDocument(25000)},
+      {"Numbers", numberDocument(20000)},
+      {"Strings", stringDocument(7000)},
+      {"Nested", deepDocument(500, 400000)},
+      {"WideObject", wideObject(100000)},
+      {"LargeArray", largeArray(400000)},
+      {"Pretty", prettyDocument(12000)},
+  };
+  return documents;
+}
+
+// The corpus document called `name`.
+inline auto corpusDocument(std::string_view name) -> const Document& {
+  for (const auto& document : corpus()) {
+    if (document.name == name) return document;
+  }
+  return corpus().front();
+}
+
+}  // namespace bench
+
+#endif  // DOCUMENTS_HH
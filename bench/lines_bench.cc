@@ -0,0 +1,51 @@
+#include <atomic>
+#include <string>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json_lines.hh"
+
+namespace {
+
+auto linesDocument() -> const std::string& {
+  static const auto document = bench::lineDocuments(200000);
+  return document;
+}
+
+void parseLines(bench::State& state, unsigned threads) {
+  const auto& source = linesDocument();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(200000, "documents");
+  state.run([&] {
+    auto results = json::parseLines(source, {}, threads);
+    bench::doNotOptimize(results.size());
+  });
+}
+
+void forEachLine(bench::State& state, unsigned threads) {
+  const auto& source = linesDocument();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(200000, "documents");
+  state.run([&] {
+    std::atomic<size_t> errors{0};
+    json::forEachLine(
+        source,
+        [&](size_t, json::Status status, const json::Json&) {
+          if (status != json::Status::Ok) ++errors;
+        },
+        {}, threads);
+    bench::doNotOptimize(errors.load());
+  });
+}
+
+}  // namespace
+
+BENCHMARK(JsonLines_Parse1Thread) { parseLines(state, 1); }
+BENCHMARK(JsonLines_Parse2Threads) { parseLines(state, 2); }
+BENCHMARK(JsonLines_Parse4Threads) { parseLines(state, 4); }
+BENCHMARK(JsonLines_Parse8Threads) { parseLines(state, 8); }
+
+BENCHMARK(JsonLines_ForEach1Thread) { forEachLine(state, 1); }
+BENCHMARK(JsonLines_ForEach2Threads) { forEachLine(state, 2); }
+BENCHMARK(JsonLines_ForEach4Threads) { forEachLine(state, 4); }
+BENCHMARK(JsonLines_ForEach8Threads) { forEachLine(state, 8); }
@@ -0,0 +1,124 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json.hh"
+#include "json/key.hh"
+#include "json/path.hh"
+
+namespace {
+
+// Looks up every member of an object with `members` members once per
+// iteration, in an order unrelated to the document order.
+void lookupMembers(bench::State& state, int members, bool key_index) {
+  const auto source = bench::wideObject(members);
+  const auto json = json::Json::parse(
+      source, {.key_index_threshold = key_index ? 1U : 0U});
+
+  std::vector<std::string> keys;
+  for (int i = 0; i != members; ++i)
+    keys.push_back("member" + std::to_string((i * 7919) % members));
+
+  state.setItemsProcessed(keys.size(), "lookups");
+  state.run([&] {
+    for (const auto& key : keys) bench::doNotOptimize((*json)[key].number());
+  });
+}
+
+// A request with 8 sections of 16 fields, of which routing reads 40.
+auto request() -> const std::string& {
+  static const auto document = [] {
+    std::string source = R"({"items": )" + bench::mixedDocument(20);
+    for (int section = 0; section != 8; ++section) {
+      source += R"(, "section)" + std::to_string(section) + R"(": {)";
+      for (int field = 0; field != 16; ++field) {
+        if (field != 0) source += ", ";
+        source += R"("field)" + std::to_string(field) + R"(": )" +
+                  std::to_string(section * field);
+      }
+      source += "}";
+    }
+    return source + "}";
+  }();
+  return document;
+}
+
+auto routedFields() -> std::vector<std::pair<std::string, std::string>> {
+  std::vector<std::pair<std::string, std::string>> fields;
+  for (int section = 0; section != 8; ++section) {
+    for (int field = 11; field != 16; ++field)
+      fields.emplace_back("section" + std::to_string(section),
+                          "field" + std::to_string(field));
+  }
+  return fields;
+}
+
+}  // namespace
+
+BENCHMARK(Json_Lookup40FieldsByChaining) {
+  const auto json = json::Json::parse(request());
+  const auto fields = routedFields();
+  state.setItemsProcessed(fields.size(), "lookups");
+  state.run([&] {
+    for (const auto& [section, field] : fields)
+      bench::doNotOptimize((*json)[section][field].number());
+  });
+}
+
+BENCHMARK(Json_Lookup40FieldsByPath) {
+  const auto json = json::Json::parse(request());
+  std::vector<json::Path> paths;
+  for (const auto& [section, field] : routedFields())
+    paths.push_back(*json::Path::compile("/" + section + "/" + field));
+  state.setItemsProcessed(paths.size(), "lookups");
+  state.run([&] {
+    for (const auto& path : paths)
+      bench::doNotOptimize(path.find(*json).number());
+  });
+}
+
+BENCHMARK(Json_Lookup40FieldsByPathSet) {
+  const auto json = json::Json::parse(request());
+  json::PathSet paths;
+  for (const auto& [section, field] : routedFields())
+    paths.add(*json::Path::compile("/" + section + "/" + field));
+  std::vector<json::Json::value_iterator> results;
+  state.setItemsProcessed(paths.size(), "lookups");
+  state.run([&] {
+    paths.find(*json, results);
+    bench::doNotOptimize(results.data());
+  });
+}
+
+BENCHMARK(Json_LookupFieldByName) {
+  const auto json = json::Json::parse(request());
+  state.setItemsProcessed(1, "lookups");
+  state.run([&] {
+    bench::doNotOptimize((*json)["section7"]["field15"].number());
+  });
+}
+
+BENCHMARK(Json_LookupFieldByKeyLiteral) {
+  using namespace json::literals;
+  const auto json = json::Json::parse(request());
+  state.setItemsProcessed(1, "lookups");
+  state.run([&] {
+    bench::doNotOptimize((*json)["section7"_key]["field15"_key].number());
+  });
+}
+
+BENCHMARK(Json_Lookup8Members) { lookupMembers(state, 8, false); }
+BENCHMARK(Json_Lookup64Members) { lookupMembers(state, 64, false); }
+BENCHMARK(Json_Lookup512Members) { lookupMembers(state, 512, false); }
+BENCHMARK(Json_Lookup4096Members) { lookupMembers(state, 4096, false); }
+
+BENCHMARK(Json_Lookup8MembersWithKeyIndex) { lookupMembers(state, 8, true); }
+BENCHMARK(Json_Lookup64MembersWithKeyIndex) { lookupMembers(state, 64, true); }
+BENCHMARK(Json_Lookup512MembersWithKeyIndex) {
+  lookupMembers(state, 512, true);
+}
+BENCHMARK(Json_Lookup4096MembersWithKeyIndex) {
+  lookupMembers(state, 4096, true);
+}
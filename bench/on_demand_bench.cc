@@ -0,0 +1,36 @@
+#include <string>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json.hh"
+#include "json/on_demand.hh"
+
+namespace {
+
+// A 20 KB payload of which a handler only reads a few fields.
+auto payload() -> const std::string& {
+  static const auto document = R"({"id": 4711, "items": )" +
+                               bench::mixedDocument(250) +
+                               R"(, "user": {"name": "someone", "level": 3},)"
+                               R"( "active": true})";
+  return document;
+}
+
+template <typename Document>
+void readFields(bench::State& state) {
+  const auto& source = payload();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto document = Document::parse(source);
+    bench::doNotOptimize((*document)["id"].number());
+    bench::doNotOptimize((*document)["user"]["level"].number());
+    bench::doNotOptimize((*document)["active"].boolean());
+    bench::doNotOptimize((*document)["items"][100]["id"].number());
+  });
+}
+
+}  // namespace
+
+BENCHMARK(OnDemand_ReadFieldsWithJson) { readFields<json::Json>(state); }
+BENCHMARK(OnDemand_ReadFieldsOnDemand) { readFields<json::OnDemand>(state); }
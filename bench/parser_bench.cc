@@ -0,0 +1,223 @@
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json.hh"
+#include "json/json_stream.hh"
+#include "json/tape_cache.hh"
+
+namespace {
+
+auto largeDocument() -> const std::string& {
+  static const auto document = bench::mixedDocument(250000);
+  return document;
+}
+
+void parseLargeDocument(bench::State& state,
+                        const json::ParseOptions& options) {
+  const auto& source = largeDocument();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::Json::parse(source, options);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+auto largeDocumentFile() -> const std::filesystem::path& {
+  static const auto path = [] {
+    auto path = std::filesystem::temp_directory_path() / "json_bench.json";
+    std::ofstream{path, std::ios::binary} << largeDocument();
+    return path;
+  }();
+  return path;
+}
+
+void streamLargeDocument(bench::State& state, size_t chunk_size) {
+  const std::string_view source = largeDocument();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  json::JsonStream stream;
+  state.run([&] {
+    for (size_t pos = 0; pos < source.size(); pos += chunk_size)
+      bench::doNotOptimize(stream.feed(source.substr(pos, chunk_size)));
+    auto json = stream.finish();
+    bench::doNotOptimize(json.status());
+  });
+}
+
+void parseDeepDocument(bench::State& state, int depth) {
+  constexpr int Leaves = 100000;
+  const auto source = bench::deepDocument(depth, Leaves);
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(Leaves + static_cast<size_t>(depth), "nodes");
+  state.run([&] {
+    auto json = json::Json::parse(source);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+}  // namespace
+
+BENCHMARK(Json_ParseLargeDocument) { parseLargeDocument(state, {}); }
+
+BENCHMARK(Json_ParseLargeDocumentWithStructuralIndex) {
+  parseLargeDocument(state, {.structural_index = true});
+}
+
+BENCHMARK(Json_ParseLargeDocument1Thread) {
+  parseLargeDocument(state, {.threads = 1});
+}
+BENCHMARK(Json_ParseLargeDocument2Threads) {
+  parseLargeDocument(state, {.threads = 2});
+}
+BENCHMARK(Json_ParseLargeDocument4Threads) {
+  parseLargeDocument(state, {.threads = 4});
+}
+BENCHMARK(Json_ParseLargeDocument8Threads) {
+  parseLargeDocument(state, {.threads = 8});
+}
+BENCHMARK(Json_ParseLargeDocument16Threads) {
+  parseLargeDocument(state, {.threads = 16});
+}
+
+BENCHMARK(Json_ReadAndParseFile) {
+  const auto& path = largeDocumentFile();
+  state.setBytesProcessed(largeDocument().size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    std::string source(std::filesystem::file_size(path), '\0');
+    std::ifstream{path, std::ios::binary}.read(
+        source.data(), static_cast<std::streamsize>(source.size()));
+    auto json = json::Json::parse(source);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+BENCHMARK(Json_ParseFile) {
+  const auto& path = largeDocumentFile();
+  state.setBytesProcessed(largeDocument().size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::Json::parseFile(path);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+BENCHMARK(Json_ParseFileBorrowed) {
+  const auto& path = largeDocumentFile();
+  state.setBytesProcessed(largeDocument().size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::Json::parseFile(path, {.borrow_source = true});
+    bench::doNotOptimize(json.status());
+  });
+}
+
+// The same document from a cache file written from it.
+BENCHMARK(Json_LoadCache) {
+  static const auto path = [] {
+    auto path = std::filesystem::temp_directory_path() / "json_bench.tape";
+    static_cast<void>(
+        json::writeCache(*json::Json::parse(largeDocument()), path));
+    return path;
+  }();
+  state.setBytesProcessed(largeDocument().size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::loadCache(path);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+BENCHMARK(Json_StreamLargeDocumentIn4KiBChunks) {
+  streamLargeDocument(state, 4096);
+}
+
+BENCHMARK(Json_StreamLargeDocumentIn64KiBChunks) {
+  streamLargeDocument(state, 65536);
+}
+
+BENCHMARK(Json_ParseDepth1) { parseDeepDocument(state, 1); }
+BENCHMARK(Json_ParseDepth16) { parseDeepDocument(state, 16); }
+BENCHMARK(Json_ParseDepth64) { parseDeepDocument(state, 64); }
+BENCHMARK(Json_ParseDepth256) { parseDeepDocument(state, 256); }
+
+BENCHMARK(Json_IterateLargeDocument) {
+  const auto json = json::Json::parse(largeDocument());
+  const auto root = json->begin();
+  size_t values = 0;
+  for (const auto& record : root) {
+    for (const auto& member : record) {
+      bench::doNotOptimize(member.number());
+      ++values;
+    }
+  }
+  state.setBytesProcessed(largeDocument().size());
+  state.setItemsProcessed(values, "values");
+  state.run([&] {
+    for (const auto& record : root) {
+      for (const auto& member : record) bench::doNotOptimize(member.number());
+    }
+  });
+}
+
+BENCHMARK(Json_ParseNumbers) {
+  static const auto source = bench::numberDocument(100000);
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::Json::parse(source);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+BENCHMARK(Json_IndexLargeArray) {
+  const auto source = bench::mixedDocument(20000);
+  const auto json = json::Json::parse(source);
+  const auto root = json->begin();
+  state.setItemsProcessed(root.size(), "elements");
+  state.run([&] {
+    for (size_t idx = 0; idx != root.size(); ++idx)
+      bench::doNotOptimize(root[idx]["tags"][2].boolean());
+  });
+}
+
+BENCHMARK(Json_ParseSmallDocuments) {
+  static const auto source = bench::mixedDocument(1);
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::Json::parse(source);
+    bench::doNotOptimize(json.status());
+  });
+}
+
+BENCHMARK(Json_ParseSmallDocumentsInto) {
+  static const auto source = bench::mixedDocument(1);
+  json::Json json;
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    bench::doNotOptimize(json::Json::parseInto(json, source));
+  });
+}
+
+// One arena per request, released all at once.
+BENCHMARK(Json_ParseSmallDocumentsMonotonic) {
+  static const auto source = bench::mixedDocument(1);
+  std::pmr::monotonic_buffer_resource arena;
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    {
+      auto json = json::Json::parse(source, {.memory_resource = &arena});
+      bench::doNotOptimize(json.status());
+    }
+    arena.release();
+  });
+}
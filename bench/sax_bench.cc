@@ -0,0 +1,47 @@
+#include <string>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json.hh"
+#include "json/sax.hh"
+
+namespace {
+
+auto largeDocument() -> const std::string& {
+  static const auto document = bench::mixedDocument(250000);
+  return document;
+}
+
+struct NumberSum : json::SaxHandler {
+  double total = 0;
+  void onNumber(double value) { total += value; }
+};
+
+}  // namespace
+
+// Both sum the numbers of every record, once through a document and once
+// straight from the parser's events.
+BENCHMARK(Sax_SumNumbersWithDocument) {
+  const auto& source = largeDocument();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    auto json = json::Json::parse(source);
+    double total = 0;
+    for (const auto& record : json->begin()) {
+      for (const auto& member : record) total += member.number().value_or(0);
+    }
+    bench::doNotOptimize(total);
+  });
+}
+
+BENCHMARK(Sax_SumNumbersWithEvents) {
+  const auto& source = largeDocument();
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(1, "documents");
+  state.run([&] {
+    NumberSum sum;
+    bench::doNotOptimize(json::parseEvents(source, sum));
+    bench::doNotOptimize(sum.total);
+  });
+}
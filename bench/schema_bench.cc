@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "bench/benchmark.hh"
+#include "json/binding.hh"
+#include "json/json.hh"
+#include "json/schema_decoder.hh"
+
+namespace {
+
+struct Item {
+  std::string sku;
+  uint32_t count{};
+  double price{};
+};
+
+struct Order {
+  int64_t id{};
+  std::string user;
+  bool express{};
+  std::optional<std::string> note;
+  std::vector<Item> items;
+};
+
+// One message of the shape an endpoint expects, about 600 bytes.
+auto message() -> const std::string& {
+  static const auto source = [] {
+    std::string text = R"({"id": 1234567, "user": "someone@example.com", )"
+                       R"("express": false, "note": null, "items": [)";
+    for (int item = 0; item != 10; ++item) {
+      if (item != 0) text += ", ";
+      text += R"({"sku": "SKU-)" + std::to_string(item * 7919) +
+              R"(", "count": )" + std::to_string(item + 1) +
+              R"(, "price": 12.95})";
+    }
+    return text + "]}";
+  }();
+  return source;
+}
+
+}  // namespace
+
+template <>
+struct json::Fields<Item> {
+  static constexpr auto list = std::tuple{json::field("sku", &Item::sku),
+                                          json::field("count", &Item::count),
+                                          json::field("price", &Item::price)};
+};
+
+template <>
+struct json::Fields<Order> {
+  static constexpr auto list =
+      std::tuple{json::field("id", &Order::id),
+                 json::field("user", &Order::user),
+                 json::field("express", &Order::express),
+                 json::field("note", &Order::note),
+                 json::field("items", &Order::items)};
+};
+
+BENCHMARK(Schema_ParseMessage) {
+  state.setBytesProcessed(message().size());
+  state.setItemsProcessed(1, "messages");
+  json::Json json;
+  state.run([&] {
+    bench::doNotOptimize(json::Json::parseInto(json, message()));
+  });
+}
+
+BENCHMARK(Schema_DecodeMessage) {
+  state.setBytesProcessed(message().size());
+  state.setItemsProcessed(1, "messages");
+  Order order;
+  state.run([&] { bench::doNotOptimize(json::decode(message(), order)); });
+}
+
+BENCHMARK(Schema_DecodeMessageWithSchema) {
+  state.setBytesProcessed(message().size());
+  state.setItemsProcessed(1, "messages");
+  Order order;
+  state.run(
+      [&] { bench::doNotOptimize(json::decodeSchema(message(), order)); });
+}
@@ -0,0 +1,45 @@
+#include <string>
+#include <vector>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/json.hh"
+#include "json/serializer.hh"
+
+namespace {
+
+void serialize(bench::State& state, const std::string& source,
+               const json::SerializeOptions& options) {
+  const auto json = json::Json::parse(source);
+  std::string out;
+  json::serializeInto(json->begin(), out, options);
+  state.setBytesProcessed(out.size());
+  state.run([&] {
+    out.clear();
+    json::serializeInto(json->begin(), out, options);
+    bench::doNotOptimize(out.data());
+  });
+}
+
+}  // namespace
+
+BENCHMARK(Serializer_Compact) {
+  serialize(state, bench::mixedDocument(10000), {});
+}
+
+BENCHMARK(Serializer_Pretty) {
+  serialize(state, bench::mixedDocument(10000), {.pretty = true});
+}
+
+BENCHMARK(Serializer_Numbers) {
+  serialize(state, bench::numberDocument(10000), {});
+}
+
+BENCHMARK(Serializer_IntoBuffer) {
+  const auto json = json::Json::parse(bench::mixedDocument(10000));
+  std::vector<char> buffer(json::serialize(*json).size());
+  state.setBytesProcessed(buffer.size());
+  state.run([&] {
+    bench::doNotOptimize(*json::serializeInto(json->begin(), buffer));
+  });
+}
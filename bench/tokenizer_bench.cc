@@ -0,0 +1,28 @@
+#include <string>
+#include <string_view>
+
+#include "bench/benchmark.hh"
+#include "bench/documents.hh"
+#include "json/tokenizer.hh"
+
+namespace {
+
+auto countTokens(std::string_view source) -> size_t {
+  size_t tokens = 0;
+  while (!source.empty()) {
+    auto maybe_token = json::internal::Tokenizer::parse(source);
+    if (!maybe_token) break;
+    bench::doNotOptimize(*maybe_token);
+    ++tokens;
+  }
+  return tokens;
+}
+
+}  // namespace
+
+BENCHMARK(Tokenizer_MixedDocument) {
+  static const auto source = bench::mixedDocument(20000);
+  state.setBytesProcessed(source.size());
+  state.setItemsProcessed(countTokens(source), "tokens");
+  state.run([&] { bench::doNotOptimize(countTokens(source)); });
+}
@@ -0,0 +1,133 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "json/builder.hh"
+#include "json/json.hh"
+#include "testrunner/testrunner.h"
+
+// Counts every allocation made through the global operator new.
+namespace {
+size_t allocations = 0;
+}  // namespace
+
+auto operator new(size_t size) -> void* {
+  ++allocations;
+  if (void* ptr = std::malloc(size)) return ptr;  // NOLINT
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }  // NOLINT
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  std::free(ptr);  // NOLINT
+}
+
+// std::pmr::new_delete_resource() allocates with the alignment it is asked
+// for.
+auto operator new(size_t size, std::align_val_t alignment) -> void* {
+  ++allocations;
+  const auto align = static_cast<size_t>(alignment);
+  if (void* ptr = std::aligned_alloc(align, (size / align + 1) * align))
+    return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept {
+  std::free(ptr);  // NOLINT
+}
+
+void operator delete(void* ptr, size_t /*size*/,
+                     std::align_val_t /*alignment*/) noexcept {
+  std::free(ptr);  // NOLINT
+}
+
+namespace {
+
+auto requestBody(int id) -> std::string {
+  return R"({"id": )" + std::to_string(id) +
+         R"(, "user": {"name": "user)" + std::to_string(id % 10) +
+         R"(", "roles": ["admin", "dev"]}, "active": true, "score": 0.5})";
+}
+
+}  // namespace
+
+TEST(Allocations_ParseIntoReusesStorage) {
+  std::vector<std::string> bodies;
+  for (int id = 0; id != 100; ++id) bodies.push_back(requestBody(id));
+
+  // Sanity check: a fresh parse has to allocate its storage.
+  const auto initial = allocations;
+  ASSERT_TRUE(json::Json::parse(bodies.front()));
+  ASSERT_TRUE(allocations > initial);
+
+  for (auto options : {json::ParseOptions{},
+                       json::ParseOptions{.structural_index = true},
+                       json::ParseOptions{.borrow_source = true}}) {
+    json::Json document;
+    ASSERT_EQ(json::Json::parseInto(document, bodies.front(), options),
+              json::Status::Ok);
+
+    const auto before = allocations;
+    for (const auto& body : bodies) {
+      ASSERT_EQ(json::Json::parseInto(document, body, options),
+                json::Status::Ok);
+      EXPECT_TRUE(document["user"]["roles"][1].string() == "dev");
+    }
+    EXPECT_EQ(allocations, before);
+  }
+}
+
+TEST(Allocations_ParseIntoLeavesEmptyDocumentOnError) {
+  json::Json document;
+  ASSERT_EQ(json::Json::parseInto(document, R"({"a": 1})"), json::Status::Ok);
+  EXPECT_TRUE(document.has("a"));
+
+  EXPECT_EQ(json::Json::parseInto(document, R"({"a": ])"),
+            json::Status::UnexpectedToken);
+  EXPECT_FALSE(document.has("a"));
+  EXPECT_TRUE(document.begin() == document.end());
+}
+
+TEST(Allocations_DocumentsUseTheirMemoryResource) {
+  // Anything beyond the buffer would fail.
+  std::array<std::byte, 64 * 1024> buffer{};
+  std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource()};
+  const auto body = requestBody(7);
+  // The parser state parseInto() keeps uses the default resource.
+  json::Json warm_up;
+  ASSERT_EQ(json::Json::parseInto(warm_up, body), json::Status::Ok);
+
+  const auto before = allocations;
+  for (auto options :
+       {json::ParseOptions{.memory_resource = &arena},
+        json::ParseOptions{.borrow_source = true,
+                           .key_index_threshold = 1,
+                           .memory_resource = &arena}}) {
+    auto document = json::Json::parse(body, options);
+    ASSERT_TRUE(document);
+    EXPECT_TRUE((*document)["user"]["roles"][1].string() == "dev");
+    EXPECT_TRUE(document->memoryResource() == &arena);
+
+    json::Json reused{&arena};
+    ASSERT_EQ(json::Json::parseInto(reused, body, options), json::Status::Ok);
+    EXPECT_TRUE(reused.memoryResource() == &arena);
+  }
+
+  json::Builder builder{{.memory_resource = &arena}};
+  builder.beginObject();
+  builder.add("id", 7);
+  builder.endObject();
+  const auto built = builder.finish();
+  ASSERT_TRUE(built);
+  EXPECT_EQ((*built)["id"].integer(), int64_t{7});
+  EXPECT_TRUE(built->memoryResource() == &arena);
+
+  EXPECT_EQ(allocations, before);
+}
@@ -0,0 +1,425 @@
+#ifndef BINDING_HH
+#define BINDING_HH
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "json/character_utils.hh"
+#include "json/key.hh"
+#include "json/number_scanner.hh"
+#include "json/serializer.hh"
+#include "json/status.hh"
+#include "json/token.hh"
+#include "json/tokenizer.hh"
+
+//
+// Decodes documents straight into C++ types, and encodes them back.
+//
+// Decoding reads tokens one by one and stores each value where it belongs;
+// no document is built on the way. Members without a field are skipped by
+// their tokens, only checking that brackets match. Fields the document does
+// not mention keep their previous values.
+//
+// Supported are bool, integers (which must be integral in the document and
+// fit the type), floating point numbers, std::string, std::optional (null,
+// or the contained type), std::vector, std::map with std::string keys, and
+// structs with a json::Fields specialization:
+//
+//   struct User {
+//     std::string name;
+//     int64_t id{};
+//     std::vector<std::string> tags;
+//   };
+//
+//   template <>
+//   struct json::Fields<User> {
+//     static constexpr auto list =
+//         std::tuple{json::field("name", &User::name),
+//                    json::field("id", &User::id),
+//                    json::field("tags", &User::tags)};
+//   };
+//
+//   User user;
+//   auto status = json::decode(source, user);
+//   auto text = json::encode(user);
+//
+
+namespace json {
+
+// Specialize with a static constexpr tuple `list` of json::field()s.
+template <typename T>
+struct Fields;
+
+template <typename Class, typename Member>
+struct Field {
+  Key key;
+  Member Class::*member;
+};
+
+template <typename Class, typename Member>
+consteval auto field(std::string_view name, Member Class::*member)
+    -> Field<Class, Member> {
+  return {Key{name}, member};
+}
+
+namespace internal {
+
+template <typename T>
+concept Bound = requires { Fields<T>::list; };
+
+template <typename T>
+concept OptionalValue =
+    requires { typename T::value_type; } &&
+    std::same_as<T, std::optional<typename T::value_type>>;
+
+template <typename T>
+concept VectorValue = requires { typename T::value_type; } &&
+                      std::same_as<T, std::vector<typename T::value_type>>;
+
+template <typename T>
+concept StringMapValue =
+    requires { typename T::mapped_type; } &&
+    std::same_as<T, std::map<std::string, typename T::mapped_type>>;
+
+template <typename T>
+concept IntegerValue = std::integral<T> && !std::same_as<T, bool>;
+
+// The value of `number`, scanned from `text`, as a T, if it is integral in
+// the document and fits. "-0" is integral too, though it is scanned as a
+// double to keep its sign.
+template <IntegerValue T>
+[[nodiscard]] auto integralValue(ScannedNumber number, std::string_view text)
+    -> std::optional<T> {
+  switch (number.kind) {
+    case ScannedNumber::Kind::Integer:
+      if (std::in_range<T>(number.integer()))
+        return static_cast<T>(number.integer());
+      break;
+    case ScannedNumber::Kind::UInt64:
+      if (std::in_range<T>(number.uint64()))
+        return static_cast<T>(number.uint64());
+      break;
+    case ScannedNumber::Kind::Double:
+      if (number.real() == 0 && text.find_first_of(".eE") == text.npos)
+        return T{0};
+      break;
+  }
+  return std::nullopt;
+}
+
+// Reads values of known types from the token stream of one document.
+class Decoder {
+  std::string_view rest_;
+  // Unescaped member names.
+  std::string name_;
+  // Brackets of the value being skipped that are still open.
+  std::vector<Token::Type> open_;
+
+ public:
+  explicit Decoder(std::string_view json_source) : rest_{json_source} {}
+
+  // The document's value, and nothing after it.
+  template <typename T>
+  [[nodiscard]] auto document(T& value) -> Status {
+    auto token = next();
+    if (!token) return token.status();
+    auto status = read(*token, value);
+    if (status != Status::Ok) return status;
+
+    auto trailing = Tokenizer::parse(rest_);
+    if (trailing) return Status::UnexpectedToken;
+    return trailing.status();
+  }
+
+ private:
+  // The next token; the input must not end before the document does.
+  [[nodiscard]] auto next() -> StatusOr<Token> {
+    auto token = Tokenizer::parse(rest_);
+    if (!token && token.status() == Status::Ok)
+      return Status::UnexpectedToken;
+    return token;
+  }
+
+  [[nodiscard]] auto expect(Token::Type type) -> Status {
+    auto token = next();
+    if (!token) return token.status();
+    return token->type == type ? Status::Ok : Status::UnexpectedToken;
+  }
+
+  // Reads the value that starts with `token` into `value`.
+  // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  template <typename T>
+  [[nodiscard]] auto read(const Token& token, T& value) -> Status {
+    if (!token.startsAValue()) return Status::UnexpectedToken;
+
+    if constexpr (OptionalValue<T>) {
+      if (token.type == Token::Type::Null) {
+        value.reset();
+        return Status::Ok;
+      }
+      if (!value) value.emplace();
+      return read(token, *value);
+    } else if constexpr (std::same_as<T, bool>) {
+      if (token.type != Token::Type::True && token.type != Token::Type::False)
+        return Status::TypeMismatch;
+      value = token.type == Token::Type::True;
+      return Status::Ok;
+    } else if constexpr (IntegerValue<T>) {
+      if (token.type != Token::Type::Number) return Status::TypeMismatch;
+      const auto integral = integralValue<T>(token.number, token.value);
+      if (!integral) return Status::TypeMismatch;
+      value = *integral;
+      return Status::Ok;
+    } else if constexpr (std::floating_point<T>) {
+      if (token.type != Token::Type::Number) return Status::TypeMismatch;
+      value = static_cast<T>(token.number.real());
+      return Status::Ok;
+    } else if constexpr (std::same_as<T, std::string>) {
+      if (token.type != Token::Type::String) return Status::TypeMismatch;
+      value.clear();
+      if (token.value.find('\\') == std::string_view::npos) {
+        value.assign(token.value);
+        return Status::Ok;
+      }
+      return unescape(token.value, value) ? Status::Ok
+                                          : Status::UnexpectedCharacter;
+    } else if constexpr (VectorValue<T>) {
+      if (token.type != Token::Type::LeftSquareBracket)
+        return Status::TypeMismatch;
+      value.clear();
+      return elements([&](const Token& element) {
+        // Not into emplace_back(), which is a proxy for std::vector<bool>.
+        typename T::value_type decoded{};
+        const auto status = read(element, decoded);
+        value.push_back(std::move(decoded));
+        return status;
+      });
+    } else if constexpr (StringMapValue<T>) {
+      if (token.type != Token::Type::LeftCurlyBracket)
+        return Status::TypeMismatch;
+      value.clear();
+      return members([&](std::string_view name, const Token& member) {
+        return read(member, value[std::string{name}]);
+      });
+    } else {
+      static_assert(Bound<T>, "json::Fields<T> is not specialized");
+      if (token.type != Token::Type::LeftCurlyBracket)
+        return Status::TypeMismatch;
+      return members([&](std::string_view name, const Token& member) {
+        return readField(name, member, value);
+      });
+    }
+  }
+
+  // Decodes the member into the field called `name`, or skips it.
+  template <typename T>
+  [[nodiscard]] auto readField(std::string_view name, const Token& token,
+                               T& value) -> Status {
+    auto status = Status::Ok;
+    const auto matched = std::apply(
+        [&](const auto&... fields) {
+          return (... || (fields.key.name() == name &&
+                          (status = read(token, value.*fields.member),
+                           true)));
+        },
+        Fields<T>::list);
+    return matched ? status : skip(token);
+  }
+
+  // Calls `element(token)` for the first token of every element of the
+  // array whose "[" was just read.
+  template <typename Element>
+  [[nodiscard]] auto elements(const Element& element) -> Status {
+    auto token = next();
+    if (!token) return token.status();
+    if (token->type == Token::Type::RightSquareBracket) return Status::Ok;
+
+    while (true) {
+      auto status = element(*token);
+      if (status != Status::Ok) return status;
+
+      token = next();
+      if (!token) return token.status();
+      if (token->type == Token::Type::RightSquareBracket) return Status::Ok;
+      if (token->type != Token::Type::Comma) return Status::UnexpectedToken;
+      token = next();
+      if (!token) return token.status();
+    }
+  }
+
+  // Calls `member(name, token)` with the unescaped name and the first token
+  // of the value of every member of the object whose "{" was just read.
+  template <typename Member>
+  [[nodiscard]] auto members(const Member& member) -> Status {
+    auto token = next();
+    if (!token) return token.status();
+    if (token->type == Token::Type::RightCurlyBracket) return Status::Ok;
+
+    while (true) {
+      if (token->type != Token::Type::String) return Status::UnexpectedToken;
+      auto name = token->value;
+      if (name.find('\\') != std::string_view::npos) {
+        name_.clear();
+        if (!unescape(name, name_)) return Status::UnexpectedCharacter;
+        name = name_;
+      }
+
+      auto status = expect(Token::Type::Colon);
+      if (status != Status::Ok) return status;
+      token = next();
+      if (!token) return token.status();
+      status = member(name, *token);
+      if (status != Status::Ok) return status;
+
+      token = next();
+      if (!token) return token.status();
+      if (token->type == Token::Type::RightCurlyBracket) return Status::Ok;
+      if (token->type != Token::Type::Comma) return Status::UnexpectedToken;
+      token = next();
+      if (!token) return token.status();
+    }
+  }
+
+  // Skips the value that starts with `token`. Nested tokens are only
+  // checked for matching brackets.
+  [[nodiscard]] auto skip(const Token& token) -> Status {
+    if (!token.startsAValue()) return Status::UnexpectedToken;
+    if (!token.isOpening()) return Status::Ok;
+
+    open_.assign(1, token.type);
+    while (!open_.empty()) {
+      auto nested = next();
+      if (!nested) return nested.status();
+      switch (nested->type) {
+        case Token::Type::LeftSquareBracket:
+        case Token::Type::LeftCurlyBracket:
+          open_.push_back(nested->type);
+          break;
+        case Token::Type::RightSquareBracket:
+          if (open_.back() != Token::Type::LeftSquareBracket)
+            return Status::UnexpectedToken;
+          open_.pop_back();
+          break;
+        case Token::Type::RightCurlyBracket:
+          if (open_.back() != Token::Type::LeftCurlyBracket)
+            return Status::UnexpectedToken;
+          open_.pop_back();
+          break;
+        default:
+          break;
+      }
+    }
+    return Status::Ok;
+  }
+};
+
+// Writes values of supported types as compact JSON.
+template <typename Output>
+class Encoder {
+  Output& out_;
+
+ public:
+  explicit Encoder(Output& out) : out_{out} {}
+
+  template <typename T>
+  void write(const T& value) {
+    if constexpr (OptionalValue<T>) {
+      if (value) {
+        write(*value);
+      } else {
+        out_.write("null");
+      }
+    } else if constexpr (std::same_as<T, bool>) {
+      out_.write(value ? "true" : "false");
+    } else if constexpr (std::signed_integral<T>) {
+      writeNumber(ScannedNumber::makeInteger(value), out_);
+    } else if constexpr (IntegerValue<T>) {
+      writeNumber(ScannedNumber::makeUInt64(value), out_);
+    } else if constexpr (std::floating_point<T>) {
+      writeNumber(ScannedNumber::makeDouble(static_cast<double>(value)), out_);
+    } else if constexpr (std::same_as<T, std::string>) {
+      writeEscaped(value, out_);
+    } else if constexpr (VectorValue<T>) {
+      out_.write('[');
+      for (size_t idx = 0; idx != value.size(); ++idx) {
+        if (idx != 0) out_.write(',');
+        write(value[idx]);
+      }
+      out_.write(']');
+    } else if constexpr (StringMapValue<T>) {
+      out_.write('{');
+      bool first = true;
+      for (const auto& [name, member] : value) {
+        writeName(name, first);
+        write(member);
+      }
+      out_.write('}');
+    } else {
+      static_assert(Bound<T>, "json::Fields<T> is not specialized");
+      out_.write('{');
+      bool first = true;
+      std::apply(
+          [&](const auto&... fields) {
+            ((writeName(fields.key.name(), first), write(value.*fields.member)),
+             ...);
+          },
+          Fields<T>::list);
+      out_.write('}');
+    }
+  }
+
+ private:
+  void writeName(std::string_view name, bool& first) {
+    if (!first) out_.write(',');
+    first = false;
+    writeEscaped(name, out_);
+    out_.write(':');
+  }
+};
+
+}  // namespace internal
+
+// Decodes `json_source` into `value`. On errors, `value` may be partly
+// decoded.
+template <typename T>
+[[nodiscard]] auto decode(std::string_view json_source, T& value) -> Status {
+  internal::Decoder decoder{json_source};
+  return decoder.document(value);
+}
+
+template <typename T>
+[[nodiscard]] auto decode(std::string_view json_source) -> StatusOr<T> {
+  T value{};
+  auto status = decode(json_source, value);
+  if (status != Status::Ok) return status;
+  return value;
+}
+
+// Appends `value` to `out` as compact JSON. Empty optionals are written as
+// null, including those of struct fields.
+template <typename T>
+void encodeInto(const T& value, std::string& out) {
+  internal::StringOutput output{out};
+  internal::Encoder encoder{output};
+  encoder.write(value);
+}
+
+template <typename T>
+[[nodiscard]] auto encode(const T& value) -> std::string {
+  std::string out;
+  encodeInto(value, out);
+  return out;
+}
+
+}  // namespace json
+
+#endif  // BINDING_HH
@@ -0,0 +1,159 @@
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "json/binding.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+struct Address {
+  std::string city;
+  std::optional<int32_t> zip;
+
+  auto operator==(const Address&) const -> bool = default;
+};
+
+struct User {
+  std::string name;
+  int64_t id{};
+  double score{};
+  bool active{};
+  std::vector<std::string> tags;
+  std::optional<Address> address;
+  std::map<std::string, uint16_t> limits;
+  std::vector<Address> previous;
+
+  auto operator==(const User&) const -> bool = default;
+};
+
+struct Flags {
+  std::vector<bool> bits;
+};
+
+}  // namespace
+
+template <>
+struct json::Fields<Flags> {
+  static constexpr auto list = std::tuple{json::field("bits", &Flags::bits)};
+};
+
+template <>
+struct json::Fields<Address> {
+  static constexpr auto list = std::tuple{json::field("city", &Address::city),
+                                          json::field("zip", &Address::zip)};
+};
+
+template <>
+struct json::Fields<User> {
+  static constexpr auto list =
+      std::tuple{json::field("name", &User::name),
+                 json::field("id", &User::id),
+                 json::field("score", &User::score),
+                 json::field("active", &User::active),
+                 json::field("tags", &User::tags),
+                 json::field("address", &User::address),
+                 json::field("limits", &User::limits),
+                 json::field("previous", &User::previous)};
+};
+
+TEST(Binding_DecodesIntoStructs) {
+  const auto user = json::decode<User>(R"({
+    "id": 4711, "name": "some\"one", "unknown": {"deep": [1, {"x": []}]},
+    "score": 2.5, "active": true, "tags": ["a", "b"],
+    "address": {"city": "Berlin", "zip": null},
+    "limits": {"read": 10, "write": 2},
+    "previous": [{"city": "Bonn", "zip": 53111}, {"city": "Köln"}]
+  })");
+  ASSERT_TRUE(user);
+  EXPECT_EQ(user->name, "some\"one");
+  EXPECT_EQ(user->id, 4711);
+  EXPECT_EQ(user->score, 2.5);
+  EXPECT_TRUE(user->active);
+  EXPECT_EQ(user->tags, (std::vector<std::string>{"a", "b"}));
+  ASSERT_TRUE(user->address.has_value());
+  EXPECT_EQ(user->address->city, "Berlin");
+  EXPECT_FALSE(user->address->zip.has_value());
+  EXPECT_EQ(user->limits.at("write"), 2);
+  ASSERT_EQ(user->previous.size(), 2U);
+  EXPECT_EQ(user->previous[0].zip, std::optional<int32_t>{53111});
+  EXPECT_EQ(user->previous[1].city, "Köln");
+}
+
+TEST(Binding_RoundTrips) {
+  User user{.name = "a\nb",
+            .id = -3,
+            .score = 0.1,
+            .active = false,
+            .tags = {"x"},
+            .address = Address{"c", 1},
+            .limits = {{"k", 65535}},
+            .previous = {}};
+  const auto text = json::encode(user);
+  EXPECT_EQ(text,
+            R"({"name":"a\nb","id":-3,"score":0.1,"active":false,"tags":["x"],)"
+            R"("address":{"city":"c","zip":1},"limits":{"k":65535},)"
+            R"("previous":[]})");
+  EXPECT_EQ(*json::decode<User>(text), user);
+
+  user.address.reset();
+  EXPECT_EQ(*json::decode<User>(json::encode(user)), user);
+}
+
+TEST(Binding_RoundTripsVectorsOfBool) {
+  const auto flags = json::decode<Flags>(R"({"bits": [true, false, true]})");
+  ASSERT_TRUE(flags);
+  EXPECT_TRUE(flags->bits == (std::vector<bool>{true, false, true}));
+  EXPECT_EQ(json::encode(*flags), R"({"bits":[true,false,true]})");
+}
+
+TEST(Binding_DecodesPlainValues) {
+  EXPECT_EQ(*json::decode<std::vector<int>>(" [1, 2, 3] "),
+            (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(*json::decode<std::optional<bool>>("null"), std::nullopt);
+  EXPECT_EQ(*json::decode<uint64_t>("18446744073709551615"),
+            18446744073709551615U);
+  EXPECT_EQ(*json::decode<std::string>(R"("A")"), "A");
+  // Integral, though it is scanned as a double.
+  EXPECT_EQ(*json::decode<int32_t>("-0"), 0);
+  EXPECT_EQ(*json::decode<uint32_t>("-0"), 0U);
+  EXPECT_EQ(json::decode<User>(R"({"id": -0})")->id, 0);
+}
+
+TEST(Binding_RejectsMismatchesAndInvalidDocuments) {
+  EXPECT_EQ(json::decode<int>("1.5").status(), json::Status::TypeMismatch);
+  EXPECT_EQ(json::decode<uint8_t>("256").status(), json::Status::TypeMismatch);
+  EXPECT_EQ(json::decode<uint32_t>("-1").status(), json::Status::TypeMismatch);
+  EXPECT_EQ(json::decode<int>("-0.0").status(), json::Status::TypeMismatch);
+  EXPECT_EQ(json::decode<int>("0e0").status(), json::Status::TypeMismatch);
+  EXPECT_EQ(json::decode<std::string>("1").status(),
+            json::Status::TypeMismatch);
+  EXPECT_EQ(json::decode<User>(R"({"id": "1"})").status(),
+            json::Status::TypeMismatch);
+
+  EXPECT_EQ(json::decode<User>(R"({"id": 1)").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::decode<User>(R"({"id" 1})").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::decode<User>(R"({"other": [1}})").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::decode<std::vector<int>>("[1 2]").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::decode<int>("1 2").status(), json::Status::UnexpectedToken);
+  EXPECT_EQ(json::decode<int>("").status(), json::Status::UnexpectedToken);
+  EXPECT_EQ(json::decode<std::string>(R"("\x")").status(),
+            json::Status::UnexpectedCharacter);
+}
+
+TEST(Binding_KeepsFieldsTheDocumentDoesNotMention) {
+  User user;
+  user.name = "kept";
+  user.id = 1;
+  ASSERT_EQ(json::decode(R"({"id": 2})", user), json::Status::Ok);
+  EXPECT_EQ(user.name, "kept");
+  EXPECT_EQ(user.id, 2);
+}
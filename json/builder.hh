@@ -0,0 +1,189 @@
+#ifndef BUILDER_HH
+#define BUILDER_HH
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/number_scanner.hh"
+#include "json/parse_options.hh"
+#include "json/status.hh"
+#include "json/tape.hh"
+#include "json/tape_builder.hh"
+
+namespace json {
+
+// Builds a document from values instead of from text:
+//
+//   json::Builder builder;
+//   builder.beginObject();
+//   builder.add("id", 4711);
+//   builder.beginArray("tags");
+//   builder.add("new");
+//   builder.endArray();
+//   builder.endObject();
+//   auto json = builder.finish();
+//
+// Values go straight onto the tape, exactly as if the equivalent text had
+// been parsed. Keys and strings are taken as they are, without escape
+// sequences. Calls that do not nest into a single value, like a member
+// without a name or an endArray() that closes an object, make finish()
+// return InvalidStructure; everything up to finish() is ignored after that.
+template <typename Index>
+class BasicBuilder {
+  internal::TapeBuilder<Index> builder_;
+  // Object or Array for every container that is still open.
+  std::pmr::vector<internal::EntryType> open_;
+  ParseOptions options_;
+  Status status_{Status::Ok};
+  bool has_root_{};
+
+ public:
+  // Only options.key_index_threshold and options.memory_resource apply to
+  // built documents.
+  explicit BasicBuilder(const ParseOptions& options = {})
+      : builder_{internal::StringStorage::Copy, options.memory_resource},
+        open_{options.memory_resource},
+        options_{options} {}
+
+  // Makes room for `values` more values and keys, and `string_bytes` more
+  // bytes of key and string text.
+  void reserve(size_t values, size_t string_bytes = 0) {
+    builder_.reserve(values, string_bytes);
+  }
+
+  void beginObject() {
+    if (startValue()) open(internal::EntryType::Object);
+  }
+
+  void beginObject(std::string_view key) {
+    if (startMember(key)) open(internal::EntryType::Object);
+  }
+
+  void endObject() { close(internal::EntryType::Object); }
+
+  void beginArray() {
+    if (startValue()) open(internal::EntryType::Array);
+  }
+
+  void beginArray(std::string_view key) {
+    if (startMember(key)) open(internal::EntryType::Array);
+  }
+
+  void endArray() { close(internal::EntryType::Array); }
+
+  // Adds the document's value or the next array element.
+  template <typename T>
+  void add(const T& value) {
+    if (startValue()) append(value);
+  }
+
+  // Adds the next member of the innermost object.
+  template <typename T>
+  void add(std::string_view key, const T& value) {
+    if (startMember(key)) append(value);
+  }
+
+  // Returns the document and prepares the builder for the next one. Nothing
+  // added yet gives an empty document, as parsed from "".
+  [[nodiscard]] auto finish() -> StatusOr<BasicJson<Index>> {
+    auto status = status_;
+    if (status == Status::Ok && !open_.empty())
+      status = Status::InvalidStructure;
+    status = builder_.complete(status);
+
+    BasicJson<Index> json{options_.memory_resource};
+    json.setTape(builder_.takeTape());
+    builder_.reset(internal::Tape<Index>{options_.memory_resource},
+                   internal::StringStorage::Copy);
+    open_.clear();
+    status_ = Status::Ok;
+    has_root_ = false;
+
+    if (status != Status::Ok) return status;
+    json.indexKeys(options_);
+    return json;
+  }
+
+ private:
+  // True if a value without a name may follow: the document's value, or an
+  // array element.
+  [[nodiscard]] auto startValue() -> bool {
+    if (status_ != Status::Ok) return false;
+    if (open_.empty() ? has_root_
+                      : open_.back() != internal::EntryType::Array) {
+      status_ = Status::InvalidStructure;
+      return false;
+    }
+    has_root_ = true;
+    return true;
+  }
+
+  [[nodiscard]] auto startMember(std::string_view key) -> bool {
+    if (status_ != Status::Ok) return false;
+    if (open_.empty() || open_.back() != internal::EntryType::Object) {
+      status_ = Status::InvalidStructure;
+      return false;
+    }
+    builder_.addKey(key);
+    return true;
+  }
+
+  void open(internal::EntryType type) {
+    open_.push_back(type);
+    if (type == internal::EntryType::Object) {
+      builder_.onObjectStart();
+    } else {
+      builder_.onArrayStart();
+    }
+  }
+
+  void close(internal::EntryType type) {
+    if (status_ != Status::Ok) return;
+    if (open_.empty() || open_.back() != type) {
+      status_ = Status::InvalidStructure;
+      return;
+    }
+    open_.pop_back();
+    if (type == internal::EntryType::Object) {
+      builder_.onObjectEnd();
+    } else {
+      builder_.onArrayEnd();
+    }
+  }
+
+  void append(std::string_view value) { builder_.addString(value); }
+  void append(const char* value) { builder_.addString(value); }
+  void append(bool value) { builder_.onBoolean(value); }
+  void append(std::nullptr_t /*value*/) { builder_.onNull(); }
+  void append(double value) {
+    builder_.onNumber(internal::ScannedNumber::makeDouble(value));
+  }
+
+  // Integers stay exact, like integers parsed from text.
+  template <std::integral T>
+  void append(T value) {
+    if constexpr (std::signed_integral<T>) {
+      builder_.onNumber(
+          internal::ScannedNumber::makeInteger(static_cast<int64_t>(value)));
+    } else if (value <= static_cast<uint64_t>(
+                            std::numeric_limits<int64_t>::max())) {
+      builder_.onNumber(
+          internal::ScannedNumber::makeInteger(static_cast<int64_t>(value)));
+    } else {
+      builder_.onNumber(
+          internal::ScannedNumber::makeUInt64(static_cast<uint64_t>(value)));
+    }
+  }
+};
+
+using Builder = BasicBuilder<uint32_t>;
+
+}  // namespace json
+
+#endif  // BUILDER_HH
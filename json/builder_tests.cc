@@ -0,0 +1,96 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "json/builder.hh"
+#include "json/json.hh"
+#include "json/serializer.hh"
+#include "testrunner/testrunner.h"
+
+TEST(Builder_BuildsTheSameDocumentAsParsing) {
+  json::Builder builder;
+  builder.reserve(16, 64);
+  builder.beginObject();
+  builder.add("id", 4711);
+  builder.add("ratio", 3.5);
+  builder.add("name", "x\"y");
+  builder.beginArray("tags");
+  builder.add("new");
+  builder.add(true);
+  builder.add(nullptr);
+  builder.beginObject();
+  builder.endObject();
+  builder.beginArray();
+  builder.endArray();
+  builder.endArray();
+  builder.beginObject("user");
+  builder.add("level", uint64_t{18446744073709551615U});
+  builder.endObject();
+  builder.endObject();
+
+  const auto json = builder.finish();
+  ASSERT_TRUE(json);
+  const auto parsed = json::Json::parse(
+      R"({"id": 4711, "ratio": 3.5, "name": "x\"y",
+          "tags": ["new", true, null, {}, []],
+          "user": {"level": 18446744073709551615}})");
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(json::serialize(*json), json::serialize(*parsed));
+
+  EXPECT_EQ((*json)["name"].string(), std::string_view{"x\"y"});
+  EXPECT_EQ((*json)["id"].integer(), int64_t{4711});
+  EXPECT_EQ((*json)["tags"].size(), 5U);
+  EXPECT_EQ((*json)["tags"][3].size(), 0U);
+  EXPECT_EQ((*json)["user"]["level"].uint64(), 18446744073709551615U);
+}
+
+TEST(Builder_BuildsScalarsAndEmptyDocuments) {
+  json::Builder builder;
+  builder.add(std::string{"text"});
+  auto json = builder.finish();
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->begin().string(), std::string_view{"text"});
+
+  json = builder.finish();
+  ASSERT_TRUE(json);
+  EXPECT_TRUE(json->begin() == json->end());
+}
+
+TEST(Builder_RejectsValuesThatDoNotNest) {
+  json::Builder builder;
+  builder.add(1);
+  builder.add(2);
+  EXPECT_EQ(builder.finish().status(), json::Status::InvalidStructure);
+
+  builder.beginObject();
+  builder.add(1);
+  EXPECT_EQ(builder.finish().status(), json::Status::InvalidStructure);
+
+  builder.beginArray();
+  builder.add("key", 1);
+  EXPECT_EQ(builder.finish().status(), json::Status::InvalidStructure);
+
+  builder.beginArray();
+  builder.endObject();
+  EXPECT_EQ(builder.finish().status(), json::Status::InvalidStructure);
+
+  builder.beginArray();
+  EXPECT_EQ(builder.finish().status(), json::Status::InvalidStructure);
+
+  // The builder starts over after an error.
+  builder.beginArray();
+  builder.endArray();
+  EXPECT_TRUE(builder.finish());
+}
+
+TEST(Builder_IndexesKeys) {
+  json::Builder builder{{.key_index_threshold = 2}};
+  builder.beginObject();
+  for (int member = 0; member != 10; ++member)
+    builder.add(std::to_string(member), member);
+  builder.endObject();
+  const auto json = builder.finish();
+  ASSERT_TRUE(json);
+  EXPECT_EQ((*json)["7"].integer(), int64_t{7});
+  EXPECT_FALSE(json->has("10"));
+}
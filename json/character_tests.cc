@@ -1,4 +1,4 @@
-#include "character_utils.hh"
+#include "json/number_scanner.hh"
 #include "testrunner/testrunner.h"
 
 TEST(CharacterUtils_EmptyNumbersStringIsEmpty) {
@@ -1,11 +1,11 @@
 #ifndef CHARACTER_UTILS_HH
 #define CHARACTER_UTILS_HH
 
+#include <array>
+#include <cstdint>
+#include <string>
 #include <string_view>
 
-#include "utility/fixed_stack.hh"
-#include "utility/one_of.hh"
-
 namespace json::internal {
 
 [[nodiscard]] constexpr auto isDigit(char chr) -> bool {
@@ -17,91 +17,173 @@ namespace json::internal {
   return chr >= 'a' && chr <= 'z';
 }
 
-[[nodiscard]] constexpr auto extractLowerCaseAlpha(std::string_view str)
-    -> std::string_view {
-  size_t idx = 0;
-  while (idx < str.length() && isLowerCaseAlpha(str[idx])) ++idx;
-  return str.substr(0, idx);
+// Classification of the first byte of a token. The tokenizer looks this up
+// once per token and dispatches straight to the matching scanner.
+enum class CharClass : uint8_t {
+  Invalid,
+  Whitespace,
+  LeftSquareBracket,
+  LeftCurlyBracket,
+  RightSquareBracket,
+  RightCurlyBracket,
+  Colon,
+  Comma,
+  Quote,
+  Number,
+  LiteralTrue,
+  LiteralFalse,
+  LiteralNull
+};
+
+inline constexpr auto CharClasses = [] {
+  std::array<CharClass, 256> classes{};
+  for (auto& cls : classes) cls = CharClass::Invalid;
+
+  //" Whitespace is any sequence of one or more of the following code points:
+  //" character tabulation (U+0009), line feed (U+000A), carriage return
+  //" (U+000D), and space (U+0020).
+  for (unsigned char chr : {'\t', '\n', '\r', ' '})
+    classes[chr] = CharClass::Whitespace;
+
+  classes['['] = CharClass::LeftSquareBracket;
+  classes['{'] = CharClass::LeftCurlyBracket;
+  classes[']'] = CharClass::RightSquareBracket;
+  classes['}'] = CharClass::RightCurlyBracket;
+  classes[':'] = CharClass::Colon;
+  classes[','] = CharClass::Comma;
+  classes['"'] = CharClass::Quote;
+
+  classes['-'] = CharClass::Number;
+  for (unsigned char chr = '0'; chr <= '9'; ++chr)
+    classes[chr] = CharClass::Number;
+
+  classes['t'] = CharClass::LiteralTrue;
+  classes['f'] = CharClass::LiteralFalse;
+  classes['n'] = CharClass::LiteralNull;
+  return classes;
+}();
+
+[[nodiscard]] constexpr auto classify(char chr) -> CharClass {
+  return CharClasses[static_cast<unsigned char>(chr)];
 }
 
-enum class NumberParserState {
-  ExpectOptionalMinus,
-  ExpectLeadingZeroOrDigit,
-  ExpectOptionalPeriod,
-  ExpectOptionalExponent,
-  ExpectOptionalDigit,
-  ExpectDigit,
-  ExpectOptionalPlusOrMinus
-};
+[[nodiscard]] constexpr auto isWhitespace(char chr) -> bool {
+  return classify(chr) == CharClass::Whitespace;
+}
 
-using Stack = FixedStack<NumberParserState, 10>;
+// True if the character at `idx` is preceded by an odd number of
+// backslashes.
+[[nodiscard]] constexpr auto isEscaped(std::string_view str, size_t idx)
+    -> bool {
+  size_t backslashes = 0;
+  while (idx > backslashes && str[idx - backslashes - 1] == '\\')
+    ++backslashes;
+  return backslashes % 2 == 1;
+}
 
-inline auto hasMandatoryItems(Stack& states) -> bool {
-  while (!states.empty()) {
-    if (states.pop() == one_of(NumberParserState::ExpectLeadingZeroOrDigit,
-                               NumberParserState::ExpectDigit))
-      return true;
-  }
-  return false;
+[[nodiscard]] constexpr auto hexDigitValue(char chr) -> int {
+  if (chr >= '0' && chr <= '9') return chr - '0';
+  if (chr >= 'a' && chr <= 'f') return chr - 'a' + 10;
+  if (chr >= 'A' && chr <= 'F') return chr - 'A' + 10;
+  return -1;
 }
 
-// NOLINTNEXTLINE(readability-function-cognitive-complexity): I tried ...
-inline auto extractNumber(std::string_view str) -> std::string_view {
-  Stack states{{NumberParserState::ExpectOptionalExponent,
-                NumberParserState::ExpectOptionalPeriod,
-                NumberParserState::ExpectLeadingZeroOrDigit,
-                NumberParserState::ExpectOptionalMinus}};
+[[nodiscard]] constexpr auto parseHex4(std::string_view str) -> int {
+  if (str.size() < 4) return -1;
+  int value = 0;
+  for (size_t idx = 0; idx != 4; ++idx) {
+    const auto digit = hexDigitValue(str[idx]);
+    if (digit < 0) return -1;
+    value = value * 16 + digit;
+  }
+  return value;
+}
 
-  size_t matched = 0;
-  while (matched != str.length() && !states.empty()) {
-    auto ch = str[matched];
+// `String` is std::string or std::pmr::string.
+template <typename String>
+void appendUtf8(uint32_t code_point, String& out) {
+  if (code_point < 0x80) {
+    out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    out += static_cast<char>(0xC0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    out += static_cast<char>(0xE0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
 
-    switch (states.pop()) {
-      case NumberParserState::ExpectOptionalMinus:
-        matched += static_cast<size_t>(ch == '-');
+// Decodes the escape sequences of a string token's contents and appends the
+// result to `out`. Returns false if an escape sequence is invalid.
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+template <typename String>
+auto unescape(std::string_view str, String& out) -> bool {
+  //"
+  //" If the code point is in the Basic Multilingual Plane (U+0000 through
+  //" U+FFFF), then it may be represented as a six-character sequence: a
+  //" reverse solidus, followed by the lowercase letter u, followed by four
+  //" hexadecimal digits that encode the code point. [...] To escape a code
+  //" point that is not in the Basic Multilingual Plane, the character may be
+  //" represented as a twelve-character sequence, encoding the UTF-16
+  //" surrogate pair corresponding to the code point.
+  //"
+  while (!str.empty()) {
+    const auto backslash = str.find('\\');
+    out.append(str.substr(0, backslash));
+    if (backslash == std::string_view::npos) return true;
+    if (backslash + 1 == str.size()) return false;
+
+    const auto escaped = str[backslash + 1];
+    str.remove_prefix(backslash + 2);
+    switch (escaped) {
+      case '"':
+      case '\\':
+      case '/':
+        out += escaped;
         break;
-
-      case NumberParserState::ExpectLeadingZeroOrDigit:
-        if (!isDigit(ch)) return "";
-        if (ch != '0') states.push(NumberParserState::ExpectOptionalDigit);
-        ++matched;
+      case 'b':
+        out += '\b';
         break;
-
-      case NumberParserState::ExpectOptionalDigit:
-        if (!isDigit(ch)) continue;
-        states.push(NumberParserState::ExpectOptionalDigit);
-        ++matched;
+      case 'f':
+        out += '\f';
         break;
-
-      case NumberParserState::ExpectDigit:
-        if (!isDigit(ch)) return "";
-        ++matched;
+      case 'n':
+        out += '\n';
         break;
-
-      case NumberParserState::ExpectOptionalPeriod:
-        if (isDigit(ch)) return "";
-        if (ch != '.') continue;
-        states.push(NumberParserState::ExpectOptionalDigit);
-        states.push(NumberParserState::ExpectDigit);
-        ++matched;
+      case 'r':
+        out += '\r';
         break;
-
-      case NumberParserState::ExpectOptionalExponent:
-        if (ch != one_of('e', 'E')) continue;
-        states.push(NumberParserState::ExpectOptionalDigit);
-        states.push(NumberParserState::ExpectDigit);
-        states.push(NumberParserState::ExpectOptionalPlusOrMinus);
-        ++matched;
+      case 't':
+        out += '\t';
         break;
-
-      case NumberParserState::ExpectOptionalPlusOrMinus:
-        matched += static_cast<size_t>(ch == one_of('+', '-'));
+      case 'u': {
+        auto code_point = parseHex4(str);
+        if (code_point < 0) return false;
+        str.remove_prefix(4);
+
+        // A high surrogate followed by an escaped low surrogate is combined
+        // into one code point. Lone surrogates are passed through.
+        const auto low =
+            str.starts_with("\\u") ? parseHex4(str.substr(2)) : -1;
+        if (code_point >= 0xD800 && code_point <= 0xDBFF && low >= 0xDC00 &&
+            low <= 0xDFFF) {
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+          str.remove_prefix(6);
+        }
+        appendUtf8(static_cast<uint32_t>(code_point), out);
         break;
+      }
+      default:
+        return false;
     }
   }
-
-  if (hasMandatoryItems(states)) return "";
-  return str.substr(0, matched);
+  return true;
 }
 
 }  // namespace json::internal
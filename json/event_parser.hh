@@ -0,0 +1,387 @@
+#ifndef EVENT_PARSER_HH
+#define EVENT_PARSER_HH
+
+#include <algorithm>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "json/character_utils.hh"
+#include "json/parse_stats.hh"
+#include "json/status.hh"
+#include "json/structural_index.hh"
+#include "json/token.hh"
+#include "json/tokenizer.hh"
+
+namespace json::internal {
+
+// The parser's state machine. It checks the grammar and reports every value
+// to `Handler` as it goes, without building anything itself:
+//
+//   void onObjectStart();              void onObjectEnd();
+//   void onArrayStart();               void onArrayEnd();
+//   Status onKey(std::string_view);    Status onString(std::string_view);
+//   void onNumber(ScannedNumber);      void onBoolean(bool);
+//   void onNull();
+//
+// Keys and strings are passed as they appear between the quotation marks,
+// escape sequences included. A handler rejects the text by returning an
+// error, which ends the parse.
+//
+// Memory use only depends on the nesting depth of the document.
+template <typename Handler>
+class EventParser {
+  enum class State {
+    ExpectValue,
+    ExpectOptionalValue,
+    ExpectEndOfObject,
+    ExpectValueName,
+    ExpectOptionalValueName,
+    ExpectOptionalCommaInObject,
+    ExpectColon,
+    ExpectEndOfArray
+  };
+
+  Handler handler_;
+  std::pmr::vector<State> states_;
+  // The last token fed to the parser, if the next chunk may continue it.
+  std::pmr::string pending_;
+
+ public:
+  explicit EventParser(
+      Handler handler,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : handler_{std::move(handler)},
+        states_{{State::ExpectValue}, resource},
+        pending_{resource} {}
+
+  [[nodiscard]] auto handler() -> Handler& { return handler_; }
+
+  [[nodiscard]] auto handler() const -> const Handler& { return handler_; }
+
+  // Prepares the parser for the next document. The handler is left alone.
+  void reset() {
+    states_.clear();
+    states_.push_back(State::ExpectValue);
+    pending_.clear();
+  }
+
+  [[nodiscard]] auto parse(std::string_view json_source) -> Status {
+    return complete(parseRange(json_source));
+  }
+
+  // Parses `elements`, a part of a document holding one or more array
+  // elements separated by commas, as the children of a placeholder array
+  // that is started but never ended. Fails unless `elements` ends right
+  // after a complete element.
+  [[nodiscard]] auto parseElements(std::string_view elements) -> Status {
+    states_.clear();
+    states_.push_back(State::ExpectEndOfArray);
+    states_.push_back(State::ExpectValue);
+    handler_.onArrayStart();
+
+    auto status = parseRange(elements);
+    if (status != Status::Ok) return status;
+    if (states_.size() != 1 || states_.back() != State::ExpectEndOfArray)
+      return Status::UnexpectedToken;
+    return Status::Ok;
+  }
+
+  // Parses the next piece of a document that arrives in chunks. Tokens may
+  // be split anywhere; only a token that runs up to the end of `chunk` is
+  // kept until the next call, so text passed to the handler may point into
+  // that copy instead of a chunk. Once an error was returned, the parser
+  // needs a reset().
+  [[nodiscard]] auto feed(std::string_view chunk) -> Status {
+    if (!pending_.empty()) {
+      const auto end = pendingTokenEnd(chunk);
+      pending_.append(chunk.substr(0, end));
+      if (end == std::string_view::npos) return Status::Ok;
+
+      chunk.remove_prefix(end);
+      auto status = parseRange(pending_);
+      pending_.clear();
+      if (status != Status::Ok) return status;
+    }
+    return parseAvailable(chunk);
+  }
+
+  // Ends a document passed in through feed().
+  [[nodiscard]] auto finish() -> Status {
+    auto status = parseRange(pending_);
+    pending_.clear();
+    return complete(status);
+  }
+
+  // Walks a prebuilt structural index instead of tokenizing byte by byte.
+  // Produces exactly the same tokens, and therefore nodes and errors, as
+  // parse() without an index.
+  [[nodiscard]] auto parse(std::string_view json_source,
+                           const StructuralIndex& index) -> Status {
+    const auto& positions = index.positions();
+    if (positions.empty()) return complete(parseRange(json_source));
+
+    auto status = parseRange(json_source.substr(0, positions.front()));
+    for (size_t idx = 0; status == Status::Ok && idx != positions.size();) {
+      size_t rest = positions[idx++];
+
+      // Strings are indexed by both quotation marks; they are the only
+      // tokens that are not scanned again.
+      if (json_source[rest] == '"') {
+        if (idx == positions.size()) return Status::UnexpectedCharacter;
+        const size_t closing_quote = positions[idx++];
+        status = parseToken(Token{
+            Token::Type::String,
+            json_source.substr(rest + 1, closing_quote - rest - 1)});
+        if (status != Status::Ok) return status;
+        rest = closing_quote + 1;
+      }
+
+      const size_t next =
+          idx == positions.size() ? json_source.size() : positions[idx];
+      status = parseRange(json_source.substr(rest, next - rest));
+    }
+    return complete(status);
+  }
+
+ private:
+  // Containers that are still open at the end of the input are accepted and
+  // ended here, innermost first.
+  [[nodiscard]] auto complete(Status status) -> Status {
+    if (status != Status::Ok) return status;
+    for (auto state = states_.rbegin(); state != states_.rend(); ++state) {
+      if (*state == State::ExpectEndOfObject) handler_.onObjectEnd();
+      if (*state == State::ExpectEndOfArray) handler_.onArrayEnd();
+    }
+    states_.clear();
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto parseRange(std::string_view json_source) -> Status {
+    while (!json_source.empty()) {
+      auto maybe_token = tokenize(json_source);
+      if (maybe_token) {
+        auto status = parseToken(*maybe_token);
+        if (status != Status::Ok) return status;
+
+      } else if (maybe_token.status() != Status::Ok) {
+        return maybe_token.status();
+      }
+    }
+    return Status::Ok;
+  }
+
+  // Tokenizer::parse(), timed for the parse statistics.
+  [[nodiscard]] static auto tokenize(std::string_view& json_source)
+      -> StatusOr<Token> {
+    const StatsTimer timer{&ParseStats::tokenizer_time};
+    return json::internal::Tokenizer::parse(json_source);
+  }
+
+  // Numbers and literal names end at whitespace or structural characters.
+  [[nodiscard]] static auto endsToken(char chr) -> bool {
+    const auto cls = classify(chr);
+    return cls != CharClass::Invalid && cls != CharClass::Number &&
+           cls != CharClass::LiteralTrue && cls != CharClass::LiteralFalse &&
+           cls != CharClass::LiteralNull;
+  }
+
+  // Length of the prefix of `chunk` that belongs to the pending token, or
+  // npos if the token may continue after all of it.
+  [[nodiscard]] auto pendingTokenEnd(std::string_view chunk) const -> size_t {
+    if (pending_.front() != '"') {
+      const auto end = std::ranges::find_if(chunk, endsToken);
+      return end == chunk.end() ? std::string_view::npos
+                                : static_cast<size_t>(end - chunk.begin());
+    }
+
+    for (auto quote = chunk.find('"'); quote != std::string_view::npos;
+         quote = chunk.find('"', quote + 1)) {
+      // The backslashes escaping a quotation mark may be in the pending part.
+      size_t backslashes = 0;
+      while (backslashes != quote && chunk[quote - backslashes - 1] == '\\')
+        ++backslashes;
+      if (backslashes == quote) {
+        for (auto chr = pending_.rbegin(); *chr == '\\'; ++chr) ++backslashes;
+      }
+      if (backslashes % 2 == 0) return quote + 1;
+    }
+    return std::string_view::npos;
+  }
+
+  // Like parseRange(), but keeps a trailing token that the next chunk may
+  // continue in pending_.
+  [[nodiscard]] auto parseAvailable(std::string_view chunk) -> Status {
+    while (true) {
+      while (!chunk.empty() && isWhitespace(chunk.front()))
+        chunk.remove_prefix(1);
+      if (chunk.empty()) return Status::Ok;
+
+      auto rest = chunk;
+      auto maybe_token = tokenize(rest);
+      if (mayContinue(chunk, maybe_token, rest)) {
+        pending_.assign(chunk);
+        return Status::Ok;
+      }
+      if (!maybe_token) return maybe_token.status();
+
+      auto status = parseToken(*maybe_token);
+      if (status != Status::Ok) return status;
+      chunk = rest;
+    }
+  }
+
+  // Strings are incomplete without their closing quotation mark, numbers and
+  // literal names until a character that cannot be part of them follows.
+  [[nodiscard]] static auto mayContinue(std::string_view chunk,
+                                        const StatusOr<Token>& maybe_token,
+                                        std::string_view rest) -> bool {
+    switch (classify(chunk.front())) {
+      case CharClass::Quote:
+        return !maybe_token;
+      case CharClass::Number:
+      case CharClass::LiteralTrue:
+      case CharClass::LiteralFalse:
+      case CharClass::LiteralNull:
+        if (maybe_token) return rest.empty();
+        return std::ranges::none_of(chunk, endsToken);
+      default:
+        return false;
+    }
+  }
+
+  [[nodiscard]] auto parseToken(const Token& token) -> Status {
+    const StatsTimer timer{&ParseStats::parser_time};
+    const GrowthCounter growth{states_};
+    countToken(token.type);
+    if (states_.empty()) return Status::UnexpectedToken;
+
+    auto state = states_.back();
+    states_.pop_back();
+
+    bool optional = true;
+    switch (state) {
+      case State::ExpectOptionalValueName:
+        if (token.type == Token::Type::String) return rememberValueName(token);
+        break;
+
+      case State::ExpectOptionalValue:
+        if (token.startsAValue()) return startNewValue(token);
+        break;
+
+      case State::ExpectOptionalCommaInObject:
+        if (token.type == Token::Type::Comma) return continueObject();
+        break;
+
+      default:
+        optional = false;
+        break;
+    }
+
+    if (optional) {
+      state = states_.back();
+      states_.pop_back();
+    }
+
+    switch (state) {
+      case State::ExpectValue:
+        return startNewValue(token);
+
+      case State::ExpectValueName:
+        return rememberValueName(token);
+
+      case State::ExpectEndOfObject:
+        return finalizeObject(token);
+
+      case State::ExpectEndOfArray:
+        if (token.type == Token::Type::Comma) return continueArray();
+        return finalizeArray(token);
+
+      case State::ExpectColon:
+        if (token.type != Token::Type::Colon) return Status::UnexpectedToken;
+        return Status::Ok;
+
+      default:
+        break;
+    }
+
+    return Status::Unimplemented;
+  }
+
+  [[nodiscard]] auto startNewValue(const Token& token) -> Status {
+    switch (token.type) {
+      case Token::Type::LeftCurlyBracket:
+        states_.push_back(State::ExpectEndOfObject);
+        states_.push_back(State::ExpectOptionalValueName);
+        handler_.onObjectStart();
+        return Status::Ok;
+
+      case Token::Type::LeftSquareBracket:
+        states_.push_back(State::ExpectEndOfArray);
+        states_.push_back(State::ExpectOptionalValue);
+        handler_.onArrayStart();
+        return Status::Ok;
+
+      case Token::Type::String:
+        return handler_.onString(token.value);
+
+      case Token::Type::Number:
+        handler_.onNumber(token.number);
+        return Status::Ok;
+
+      case Token::Type::True:
+      case Token::Type::False:
+        handler_.onBoolean(token.type == Token::Type::True);
+        return Status::Ok;
+
+      case Token::Type::Null:
+        handler_.onNull();
+        return Status::Ok;
+
+      default:
+        return Status::UnexpectedToken;
+    }
+  }
+
+  [[nodiscard]] auto rememberValueName(const Token& token) -> Status {
+    if (token.type != Token::Type::String) return Status::UnexpectedToken;
+    auto status = handler_.onKey(token.value);
+    if (status != Status::Ok) return status;
+    states_.push_back(State::ExpectOptionalCommaInObject);
+    states_.push_back(State::ExpectValue);
+    states_.push_back(State::ExpectColon);
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto continueObject() -> Status {
+    states_.push_back(State::ExpectValueName);
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto finalizeObject(const Token& token) -> Status {
+    if (token.type != Token::Type::RightCurlyBracket)
+      return Status::UnexpectedToken;
+    handler_.onObjectEnd();
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto continueArray() -> Status {
+    // TODO(ae): Need to check that we didn't start with a comma (i.e. [,true])
+    states_.push_back(State::ExpectEndOfArray);
+    states_.push_back(State::ExpectValue);
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto finalizeArray(const Token& token) -> Status {
+    if (token.type != Token::Type::RightSquareBracket)
+      return Status::UnexpectedToken;
+    handler_.onArrayEnd();
+    return Status::Ok;
+  }
+};
+
+}  // namespace json::internal
+
+#endif  // EVENT_PARSER_HH
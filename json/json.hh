@@ -1,12 +1,28 @@
 #ifndef JSON_HH
 #define JSON_HH
 
-#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
 #include <optional>
-#include <variant>
-
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "json/key.hh"
+#include "json/key_index.hh"
+#include "json/mapped_file.hh"
+#include "json/parallel_for.hh"
+#include "json/parallel_parser.hh"
+#include "json/parse_options.hh"
+#include "json/parse_stats.hh"
 #include "json/parser.hh"
 #include "json/status.hh"
+#include "json/structural_index.hh"
+#include "json/tape.hh"
+#include "json/unescaped_strings.hh"
+#include "json/value.hh"
 
 //
 // Document references in this file refer to:
@@ -31,36 +47,105 @@ class ValueIterator {
       const ValueIterator&) const noexcept = default;
 
   [[nodiscard]] auto string() const -> std::optional<std::string_view> {
-    return this->accessAs<json::String, std::string_view>();
+    const auto* entry = this->entry();
+    if (entry == nullptr || entry->type() != internal::EntryType::String)
+      return std::nullopt;
+    return container_->text(*entry);
   }
 
+  // Any number; integers beyond 2^53 may be rounded.
   [[nodiscard]] auto number() const -> std::optional<double> {
-    return this->accessAs<json::Number, double>();
+    const auto* entry = this->entry();
+    if (entry == nullptr || !entry->isNumber()) return std::nullopt;
+    return entry->scannedNumber().real();
+  }
+
+  // Integers that fit int64_t, exactly.
+  [[nodiscard]] auto integer() const -> std::optional<int64_t> {
+    const auto* entry = this->entry();
+    if (entry == nullptr || entry->type() != internal::EntryType::Integer)
+      return std::nullopt;
+    return entry->scannedNumber().integer();
+  }
+
+  // Integers that fit uint64_t, exactly.
+  [[nodiscard]] auto uint64() const -> std::optional<uint64_t> {
+    const auto* entry = this->entry();
+    if (entry == nullptr) return std::nullopt;
+    const auto number = entry->scannedNumber();
+    if (entry->type() == internal::EntryType::UInt64) return number.uint64();
+    if (entry->type() == internal::EntryType::Integer && number.integer() >= 0)
+      return number.uint64();
+    return std::nullopt;
   }
 
   [[nodiscard]] auto boolean() const -> std::optional<bool> {
-    return this->accessAs<json::Boolean, bool>();
+    const auto* entry = this->entry();
+    if (entry == nullptr || entry->type() != internal::EntryType::Boolean)
+      return std::nullopt;
+    return entry->boolean();
   }
 
-  [[nodiscard]] auto value() const -> const Value& {
-    return container_->at(idx_)->value;
+  // Null for end() and for empty documents.
+  [[nodiscard]] auto value() const -> Value {
+    const auto* entry = this->entry();
+    if (entry == nullptr) return Null{};
+    switch (entry->type()) {
+      case internal::EntryType::Object:
+        return Object{};
+      case internal::EntryType::Array:
+        return Array{};
+      case internal::EntryType::Number:
+        return Number{entry->scannedNumber().real()};
+      case internal::EntryType::Integer:
+        return Integer{entry->scannedNumber().integer()};
+      case internal::EntryType::UInt64:
+        return UInt64{entry->scannedNumber().uint64()};
+      case internal::EntryType::String:
+        return String{container_->text(*entry)};
+      case internal::EntryType::Boolean:
+        return Boolean{entry->boolean()};
+      case internal::EntryType::Null:
+      case internal::EntryType::Key:
+        break;
+    }
+    return Null{};
   }
 
   [[nodiscard]] auto name() const -> std::optional<std::string_view> {
     if (*this == container_->end()) return std::nullopt;
-    return container_->at(idx_)->name;
+    const auto* entry = container_->at(idx_);
+    if (entry->type() != internal::EntryType::Key) return std::string_view{};
+    return container_->text(*entry);
   }
 
   [[nodiscard]] auto operator*() const -> const ValueIterator& { return *this; }
 
   [[nodiscard]] auto operator[](std::string_view key) const -> ValueIterator {
-    for (const auto& child : *this) {
-      if (child.node()->name == key) return child;
-    }
-    return container_->end();
+    return member(key, [key] { return internal::hashKey(key); });
+  }
+
+  [[nodiscard]] auto operator[](const Key& key) const -> ValueIterator {
+    return member(key.name(), [&key] { return key.hash(); });
+  }
+
+  // The member reached through `Names`, one level each:
+  // value.get<"user", "name">() is value["user"_key]["name"_key].
+  template <internal::KeyLiteral... Names>
+  [[nodiscard]] auto get() const -> ValueIterator {
+    auto value = *this;
+    ((value = value[Key{Names.name()}]), ...);
+    return value;
   }
 
   [[nodiscard]] auto operator[](size_t offset) const -> ValueIterator {
+    const auto* entry = this->entry();
+    if (entry != nullptr && entry->type() == internal::EntryType::Array) {
+      if (offset >= entry->count()) return container_->end();
+      return ValueIterator{container_,
+                           container_->element(valueIndex(), offset)};
+    }
+
     for (const auto& child : *this) {
       if (0 == offset--) return child;
     }
@@ -71,18 +156,32 @@ class ValueIterator {
     return (*this)[key] != container_->end();
   }
 
+  // Number of members of an object or values of an array, 0 for anything
+  // else.
+  [[nodiscard]] auto size() const -> size_t {
+    const auto* entry = this->entry();
+    if (entry == nullptr || (entry->type() != internal::EntryType::Object &&
+                             entry->type() != internal::EntryType::Array))
+      return 0;
+    return entry->count();
+  }
+
   [[nodiscard]] auto begin() const -> ValueIterator {
     if (*this == container_->end()) return *this;
-    return ValueIterator{container_, idx_ + 1};
+    return ValueIterator{container_, valueIndex() + 1};
   }
 
   [[nodiscard]] auto end() const -> ValueIterator {
     if (*this == container_->end()) return *this;
-    return ValueIterator{container_, idx_ + 1 + container_->at(idx_)->children};
+    const auto value = valueIndex();
+    return ValueIterator{container_, value + 1 + container_->at(value)->size()};
   }
 
   auto operator++() -> ValueIterator& {
-    if (*this != container_->end()) idx_ += container_->at(idx_)->children + 1;
+    if (*this != container_->end()) {
+      const auto value = valueIndex();
+      idx_ = value + 1 + container_->at(value)->size();
+    }
     return *this;
   }
 
@@ -91,46 +190,196 @@ class ValueIterator {
   ValueIterator(const T* container, size_t idx)
       : container_{container}, idx_{idx} {}
 
-  [[nodiscard]] auto node() const -> const internal::Node* {
-    return container_->at(idx_);
+  // Object members are positioned on their key, which is directly followed
+  // by the member's value.
+  [[nodiscard]] auto valueIndex() const -> size_t {
+    const auto is_key =
+        container_->at(idx_)->type() == internal::EntryType::Key;
+    return idx_ + (is_key ? 1 : 0);
   }
 
-  template <typename Alternative, typename Returns>
-  [[nodiscard]] auto accessAs() const -> std::optional<Returns> {
-    if (node() == nullptr) return std::nullopt;
-    if (!std::holds_alternative<Alternative>(node()->value))
-      return std::nullopt;
-    return std::get<Alternative>(node()->value).value;
+  [[nodiscard]] auto entry() const {
+    return *this == container_->end() ? nullptr : container_->at(valueIndex());
+  }
+
+  // `hash()` returns the hashKey() of `key`, which only indexed objects
+  // need. Otherwise, names of a different length are skipped without
+  // looking at their text; borrowed names with escape sequences are longer
+  // on the tape than unescaped.
+  template <typename Hash>
+  [[nodiscard]] auto member(std::string_view key, const Hash& hash) const
+      -> ValueIterator {
+    const auto* entry = this->entry();
+    if (entry == nullptr || entry->type() != internal::EntryType::Object)
+      return container_->end();
+
+    if (entry->table() != 0) {
+      const auto member = container_->findMember(*entry, key, hash());
+      return member == 0 ? container_->end()
+                         : ValueIterator{container_, member};
+    }
+
+    const auto object = valueIndex();
+    const auto end = object + 1 + entry->size();
+    for (auto idx = object + 1; idx < end;
+         idx += 2 + container_->at(idx + 1)->size()) {
+      const auto* name = container_->at(idx);
+      if ((name->textLength() == key.size() || name->escaped()) &&
+          container_->text(*name) == key)
+        return ValueIterator{container_, idx};
+    }
+    return container_->end();
   }
 
   const T* container_;
   size_t idx_;
 };
 
-class Json {
-  std::vector<internal::Node> nodes_;
-
-  explicit Json(std::vector<internal::Node>&& nodes)
-      : nodes_{std::move(nodes)} {};
+template <typename Index>
+class BasicJsonStream;
+
+template <typename Index>
+class BasicBuilder;
+
+namespace internal {
+template <typename Index>
+class Serializer;
+template <typename Index>
+class PathWalker;
+template <typename Index>
+class TapeCache;
+}  // namespace internal
+
+// Documents use 32 bit tape indices by default, which limits them to 2^27
+// values and 4 GiB of string data. BasicJson<uint64_t> lifts those limits at
+// twice the memory per value.
+template <typename Index>
+class BasicJson {
+  using Entry = internal::TapeEntry<Index>;
+
+  internal::Tape<Index> tape_;
+  // Only set if strings and keys are borrowed from the source.
+  const char* source_{};
+  // Only set if any borrowed string or key needs to be unescaped.
+  std::unique_ptr<internal::UnescapedStrings> unescaped_;
+  internal::KeyIndex<Index> key_index_;
+  // Only set if strings and keys are borrowed from a parsed file, or the
+  // document was loaded from a cache file.
+  internal::MappedFile mapping_;
+  // What the document reads: tape_, or the sections of a cache file in
+  // mapping_.
+  internal::TapeView<Index> view_;
+
+  struct ParseState {
+    internal::Parser<Index> parser;
+    internal::StructuralIndex index;
+
+    ParseState() = default;
+
+    explicit ParseState(std::pmr::memory_resource* resource)
+        : parser{internal::StringStorage::Copy, resource} {}
+  };
 
  public:
-  using value_iterator = ValueIterator<Json>;
+  using value_iterator = ValueIterator<BasicJson>;
+
+  // An empty document, as parsed from "". Mostly useful as target of
+  // parseInto().
+  BasicJson() = default;
+
+  // An empty document that allocates from `resource`, which must outlive
+  // it. Parsing into it with parseInto() keeps the resource.
+  explicit BasicJson(std::pmr::memory_resource* resource)
+      : tape_{resource}, key_index_{resource} {}
+
+  // Short text of a tape lives inside its string and is copied rather than
+  // moved, so the view of a tape is made again.
+  BasicJson(BasicJson&& other) noexcept
+      : tape_{std::move(other.tape_)},
+        source_{std::exchange(other.source_, nullptr)},
+        unescaped_{std::move(other.unescaped_)},
+        key_index_{std::move(other.key_index_)},
+        mapping_{std::move(other.mapping_)},
+        view_{std::exchange(other.view_, {})} {
+    if (view_.entries.data() == tape_.entries.data()) viewTape();
+  }
+
+  auto operator=(BasicJson&& other) -> BasicJson& {
+    if (this == &other) return *this;
+    const auto views_tape = other.view_.entries.data() ==
+                            other.tape_.entries.data();
+    tape_ = std::move(other.tape_);
+    source_ = std::exchange(other.source_, nullptr);
+    unescaped_ = std::move(other.unescaped_);
+    key_index_ = std::move(other.key_index_);
+    mapping_ = std::move(other.mapping_);
+    view_ = std::exchange(other.view_, {});
+    if (views_tape) viewTape();
+    return *this;
+  }
+
+  BasicJson(const BasicJson&) = delete;
+  auto operator=(const BasicJson&) -> BasicJson& = delete;
 
-  [[nodiscard]] static auto parse(std::string_view json_source)
-      -> StatusOr<Json> {
-    internal::Parser parser;
+  ~BasicJson() = default;
 
-    auto status = parser.parse(json_source);
+  [[nodiscard]] static auto parse(std::string_view json_source,
+                                  const ParseOptions& options = {})
+      -> StatusOr<BasicJson> {
+    BasicJson json{options.memory_resource};
+    ParseState state{options.memory_resource};
+    auto status = json.parseWith(state, json_source, options);
     if (status != Status::Ok) return status;
+    return json;
+  }
+
+  // Parses the file at `path` straight from a read only memory mapping of
+  // it. With `options.borrow_source`, strings and names point into the
+  // mapping, which the document then keeps alive; otherwise the file is
+  // unmapped before returning.
+  [[nodiscard]] static auto parseFile(const std::filesystem::path& path,
+                                      const ParseOptions& options = {})
+      -> StatusOr<BasicJson> {
+    auto mapping = internal::MappedFile::open(path);
+    if (!mapping) return mapping.status();
+
+    BasicJson json{options.memory_resource};
+    ParseState state{options.memory_resource};
+    auto status = json.parseWith(state, mapping->contents(), options);
+    if (status != Status::Ok) return status;
+    if (options.borrow_source) json.mapping_ = std::move(*mapping);
+    return json;
+  }
 
-    return Json{parser.nodes()};
+  // Parses into an existing document, replacing its contents but keeping
+  // its storage and memory resource; options.memory_resource is not used.
+  // Together with the per thread parser state kept here, repeatedly parsing
+  // similar sized documents does not allocate once the buffers have grown.
+  // On failure, `json` is left empty.
+  [[nodiscard]] static auto parseInto(BasicJson& json,
+                                      std::string_view json_source,
+                                      const ParseOptions& options = {})
+      -> Status {
+    thread_local ParseState state;
+    return json.parseWith(state, json_source, options);
   }
 
   [[nodiscard]] auto operator[](std::string_view key) const -> value_iterator {
-    if (nodes_.empty()) return end();
+    if (entries().empty()) return end();
     return begin()[key];
   }
 
+  [[nodiscard]] auto operator[](const Key& key) const -> value_iterator {
+    if (entries().empty()) return end();
+    return begin()[key];
+  }
+
+  template <internal::KeyLiteral... Names>
+  [[nodiscard]] auto get() const -> value_iterator {
+    if (entries().empty()) return end();
+    return begin().template get<Names...>();
+  }
+
   [[nodiscard]] auto has(std::string_view key) const -> bool {
     return (*this)[key] != end();
   }
@@ -140,21 +389,165 @@ class Json {
   }
 
   [[nodiscard]] auto end() const -> value_iterator {
-    return ValueIterator{this, nodes_.size()};
+    return ValueIterator{this, entries().size()};
   }
 
-  [[nodiscard]] auto value() const -> const Value& {
-    return nodes_.at(0).value;
+  [[nodiscard]] auto value() const -> Value { return begin().value(); }
+
+  // Where the document allocates its storage.
+  [[nodiscard]] auto memoryResource() const -> std::pmr::memory_resource* {
+    return tape_.resource();
   }
 
  private:
+  [[nodiscard]] auto parseWith(ParseState& state, std::string_view json_source,
+                               const ParseOptions& options) -> Status {
+    const auto string_storage = options.borrow_source
+                                    ? internal::StringStorage::Borrow
+                                    : internal::StringStorage::Copy;
+    internal::ParseStatsScope stats{options.stats};
+    source_ = nullptr;
+    mapping_ = {};
+    key_index_.clear();
+
+    auto status = Status::Ok;
+    bool has_escapes = false;
+    if (!parseInParallel(json_source, string_storage, options, has_escapes)) {
+      auto& parser = state.parser;
+      parser.reset(std::move(tape_), string_storage);
+      if (options.structural_index &&
+          internal::StructuralIndex::fits(json_source)) {
+        state.index.rebuild(json_source);
+        status = parser.parse(json_source, state.index);
+      } else {
+        status = parser.parse(json_source);
+      }
+      tape_ = parser.takeTape();
+      has_escapes = parser.hasEscapes();
+    }
+    stats.result(tape_.entries.size(), tape_.strings.size());
+
+    if (status != Status::Ok) {
+      tape_.entries.clear();
+      tape_.strings.clear();
+      tape_.elements.clear();
+      viewTape();
+      return status;
+    }
+    viewTape();
+
+    if (options.borrow_source) {
+      source_ = json_source.data();
+      if (has_escapes) {
+        if (unescaped_ == nullptr)
+          unescaped_ = std::make_unique<internal::UnescapedStrings>(
+              tape_.resource());
+        unescaped_->clear();
+      }
+    }
+
+    indexKeys(options);
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto parseInParallel(std::string_view json_source,
+                                     internal::StringStorage string_storage,
+                                     const ParseOptions& options,
+                                     bool& has_escapes) -> bool {
+    const auto threads = internal::workerThreads(options.threads);
+    if (threads < 2 || json_source.size() < internal::ParallelParseMinimumSize)
+      return false;
+
+    const auto segment_size =
+        internal::parallelSegmentSize(json_source.size(), threads);
+    internal::ParallelParser<Index> parser;
+    if (!parser.parse(json_source, string_storage, threads, segment_size,
+                      tape_))
+      return false;
+    has_escapes = parser.hasEscapes();
+    return true;
+  }
+
+  friend BasicJsonStream<Index>;
+  friend BasicBuilder<Index>;
+  friend internal::Serializer<Index>;
+  friend internal::PathWalker<Index>;
+  friend internal::TapeCache<Index>;
+  void indexKeys(const ParseOptions& options) {
+    if (options.key_index_threshold == 0) return;
+    key_index_.build(tape_, options.key_index_threshold,
+                     [this](size_t idx) { return text(tape_.entries[idx]); });
+  }
+
+  // The document `value` belongs to, and the tape index of the value it
+  // refers to (the tape size for end()).
+  [[nodiscard]] static auto locate(const value_iterator& value)
+      -> std::pair<const BasicJson*, size_t> {
+    const auto* json = value.container_;
+    return {json, value == json->end() ? value.idx_ : value.valueIndex()};
+  }
+
+  // Refers to the value at tape index `idx`, or to the member whose Key
+  // entry is there.
+  [[nodiscard]] auto iteratorAt(size_t idx) const -> value_iterator {
+    return ValueIterator{this, idx};
+  }
+
+  // Reads the document's own tape, after it changed.
+  void viewTape() { view_ = {tape_.entries, tape_.strings, tape_.elements}; }
+
+  // Replaces the document's tape with one built elsewhere.
+  void setTape(internal::Tape<Index>&& tape) {
+    tape_ = std::move(tape);
+    viewTape();
+  }
+
+  [[nodiscard]] auto entries() const -> std::span<const Entry> {
+    return view_.entries;
+  }
+
+  [[nodiscard]] auto strings() const -> std::string_view {
+    return view_.strings;
+  }
+
+  [[nodiscard]] auto elements() const -> std::span<const Index> {
+    return view_.elements;
+  }
+
   friend value_iterator;
-  [[nodiscard]] auto at(size_t idx) const -> const internal::Node* {
-    if (idx >= nodes_.size()) return nullptr;
-    return &nodes_.at(idx);
+  [[nodiscard]] auto at(size_t idx) const -> const Entry* {
+    const auto entries = this->entries();
+    if (idx >= entries.size()) return nullptr;
+    return &entries[idx];
+  }
+
+  [[nodiscard]] auto text(const Entry& entry) const -> std::string_view {
+    if (source_ == nullptr)
+      return {strings().data() + entry.textOffset(), entry.textLength()};
+
+    const std::string_view text{source_ + entry.textOffset(),
+                                entry.textLength()};
+    return entry.escaped() ? unescaped_->lookup(text) : text;
+  }
+
+  // Tape index of element `offset` of the array at tape index `array`.
+  [[nodiscard]] auto element(size_t array, size_t offset) const -> size_t {
+    const auto table = entries()[array].table();
+    if (table == 0) return array + 1 + offset;
+    return array + elements()[table - 1 + offset];
+  }
+
+  // `hash` is the hashKey() of `key`.
+  [[nodiscard]] auto findMember(const Entry& object, std::string_view key,
+                                uint64_t hash) const -> size_t {
+    return key_index_.find(object, key, hash, [this](size_t idx) {
+      return text(entries()[idx]);
+    });
   }
 };
 
+using Json = BasicJson<uint32_t>;
+
 }  // namespace json
 
-#endif  // JSON_HH
\ No newline at end of file
+#endif  // JSON_HH
@@ -50,6 +50,22 @@ namespace json::formatter {
       return "Parser found an invalid token";
     case Status::Unimplemented:
       return "Unimplemented feature";
+    case Status::DocumentTooLarge:
+      return "Document exceeds the size limits of its index type";
+    case Status::CannotReadFile:
+      return "File could not be opened or mapped";
+    case Status::BufferTooSmall:
+      return "Output does not fit the buffer";
+    case Status::InvalidStructure:
+      return "Values are not nested like a document";
+    case Status::TypeMismatch:
+      return "Value does not have the type it is decoded into";
+    case Status::CannotWriteFile:
+      return "File could not be written";
+    case Status::InvalidCache:
+      return "Not a cache file of this version, byte order and index type";
+    case Status::CorruptCache:
+      return "Cache file is truncated or fails its checksum";
   }
 }
 
@@ -71,6 +87,12 @@ struct fmt::formatter<json::Value> {
             [&](const json::Number& number) {
               fmt::format_to(ctx.out(), "Number ({})", number.value);
             },
+            [&](const json::Integer& integer) {
+              fmt::format_to(ctx.out(), "Integer ({})", integer.value);
+            },
+            [&](const json::UInt64& integer) {
+              fmt::format_to(ctx.out(), "UInt64 ({})", integer.value);
+            },
             [&](const json::String& string) {
               fmt::format_to(ctx.out(), "String ({})", string.value);
             },
@@ -0,0 +1,152 @@
+#ifndef JSON_LINES_HH
+#define JSON_LINES_HH
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/parallel_for.hh"
+#include "json/parse_options.hh"
+#include "json/status.hh"
+
+//
+// Newline delimited JSON (JSON Lines, NDJSON): one document per line.
+//
+// The input is cut into batches of whole lines, which worker threads take
+// from a shared counter. Every worker parses with its own parser state (see
+// BasicJson::parseInto()), so workers share nothing but the input.
+//
+// Lines are numbered from 0. An empty line is an empty document, like
+// Json::parse(""); a newline at the very end of the input does not start
+// another line.
+//
+
+namespace json {
+
+namespace internal {
+
+// Roughly the amount of input a worker takes at a time.
+inline constexpr size_t LineBatchSize = 256 * 1024;
+
+// Cuts `source` into pieces of about `batch_size` bytes, each ending right
+// after a newline except maybe the last.
+inline auto splitLines(std::string_view source, size_t batch_size)
+    -> std::vector<std::string_view> {
+  std::vector<std::string_view> batches;
+  while (!source.empty()) {
+    const auto newline =
+        source.find('\n', std::min(batch_size, source.size()) - 1);
+    const auto end =
+        newline == std::string_view::npos ? source.size() : newline + 1;
+    batches.push_back(source.substr(0, end));
+    source.remove_prefix(end);
+  }
+  return batches;
+}
+
+// Batches of whole lines, and the number of the first line of each.
+struct LineBatches {
+  std::vector<std::string_view> batches;
+  std::vector<size_t> first_line;
+  size_t lines{};
+};
+
+[[nodiscard]] inline auto batchLines(std::string_view source, unsigned threads)
+    -> LineBatches {
+  LineBatches result{splitLines(source, LineBatchSize), {}, 0};
+  const auto& batches = result.batches;
+
+  // Counting newlines is cheap next to parsing, and runs in parallel too.
+  std::vector<size_t> newlines(batches.size());
+  parallelFor(batches.size(), threads, [&](size_t batch) {
+    newlines[batch] =
+        static_cast<size_t>(std::ranges::count(batches[batch], '\n'));
+  });
+
+  result.first_line.reserve(batches.size());
+  for (const auto count : newlines) {
+    result.first_line.push_back(result.lines);
+    result.lines += count;
+  }
+  if (!source.empty() && source.back() != '\n') ++result.lines;
+  return result;
+}
+
+// Calls `record(line, text)` for every line, concurrently.
+template <typename Record>
+void forEachRecord(const LineBatches& lines, unsigned threads,
+                   const Record& record) {
+  parallelFor(lines.batches.size(), threads, [&](size_t batch) {
+    auto line = lines.first_line[batch];
+    auto rest = lines.batches[batch];
+    while (!rest.empty()) {
+      const auto newline = rest.find('\n');
+      record(line++, rest.substr(0, newline));
+      rest.remove_prefix(newline == std::string_view::npos ? rest.size()
+                                                           : newline + 1);
+    }
+  });
+}
+
+}  // namespace internal
+
+// Parses every line of `source` on `threads` threads (0: one per core) and
+// returns the documents, or the errors, in input order. The documents
+// allocate from ParseOptions::memory_resource, which all the threads share;
+// it must be safe to use from several threads at once.
+template <typename Index = uint32_t>
+[[nodiscard]] auto parseLines(std::string_view source,
+                              const ParseOptions& options = {},
+                              unsigned threads = 0)
+    -> std::vector<StatusOr<BasicJson<Index>>> {
+  threads = internal::workerThreads(threads);
+  const auto lines = internal::batchLines(source, threads);
+
+  // Placeholders, each overwritten by exactly one worker.
+  std::vector<StatusOr<BasicJson<Index>>> results;
+  results.reserve(lines.lines);
+  for (size_t line = 0; line != lines.lines; ++line)
+    results.emplace_back(Status::Ok);
+
+  internal::forEachRecord(
+      lines, threads, [&](size_t line, std::string_view text) {
+        BasicJson<Index> json{options.memory_resource};
+        const auto status = BasicJson<Index>::parseInto(json, text, options);
+        if (status == Status::Ok)
+          results[line] = std::move(json);
+        else
+          results[line] = status;
+      });
+  return results;
+}
+
+// Like parseLines(), but hands every document to `callback(line, status,
+// json)` as soon as it is parsed instead of collecting them. Each worker
+// parses all its lines into the same document, so this does not allocate
+// once the worker's buffers have grown. `callback` is called concurrently,
+// in no particular order, and must not keep a reference to `json`. On
+// failure, `json` is empty. The workers' documents live as long as their
+// threads and allocate from the default resource, not from
+// ParseOptions::memory_resource.
+template <typename Index = uint32_t, typename Callback>
+  requires std::invocable<const Callback&, size_t, Status,
+                          const BasicJson<Index>&>
+void forEachLine(std::string_view source, const Callback& callback,
+                 const ParseOptions& options = {}, unsigned threads = 0) {
+  threads = internal::workerThreads(threads);
+  internal::forEachRecord(
+      internal::batchLines(source, threads), threads,
+      [&](size_t line, std::string_view text) {
+        thread_local BasicJson<Index> json;
+        const auto status = BasicJson<Index>::parseInto(json, text, options);
+        callback(line, status, std::as_const(json));
+      });
+}
+
+}  // namespace json
+
+#endif  // JSON_LINES_HH
@@ -0,0 +1,70 @@
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "json/json_lines.hh"
+#include "testrunner/testrunner.h"
+
+TEST(JsonLines_ParsesLinesInOrder) {
+  auto results = json::parseLines("{\"a\": 1}\n[2]\n\n{\"a\"\n3\r\n4");
+  ASSERT_EQ(results.size(), 6U);
+  EXPECT_EQ(*(*results[0])["a"].number(), 1);
+  EXPECT_EQ(*results[1]->begin()[0].number(), 2);
+  ASSERT_TRUE(results[2]);
+  EXPECT_TRUE(results[2]->begin() == results[2]->end());
+  EXPECT_EQ(results[3].status(), json::Status::Ok);
+  EXPECT_EQ(*results[4]->begin().number(), 3);
+  EXPECT_EQ(*results[5]->begin().number(), 4);
+
+  EXPECT_EQ(json::parseLines("1\n2\n").size(), 2U);
+  EXPECT_EQ(json::parseLines("").size(), 0U);
+  EXPECT_EQ(json::parseLines("[1 2]\n")[0].status(),
+            json::Status::UnexpectedToken);
+}
+
+TEST(JsonLines_DocumentsUseTheMemoryResource) {
+  std::pmr::synchronized_pool_resource pool;
+  const auto results =
+      json::parseLines("[1]\n{\"a\": \"b\"}\n", {.memory_resource = &pool}, 2);
+  ASSERT_EQ(results.size(), 2U);
+  for (const auto& result : results) {
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(result->memoryResource() == &pool);
+  }
+}
+
+TEST(JsonLines_SplitsLargeInputsAcrossThreads) {
+  constexpr size_t Lines = 50000;
+  std::string source;
+  for (size_t line = 0; line != Lines; ++line)
+    source += R"({"line": )" + std::to_string(line) + R"(, "pad": "....."})" +
+              (line % 1000 == 999 ? "]\n" : "\n");
+
+  auto results = json::parseLines(source, {}, 4);
+  ASSERT_EQ(results.size(), Lines);
+  for (size_t line = 0; line != Lines; ++line) {
+    if (line % 1000 == 999) {
+      EXPECT_FALSE(results[line]);
+    } else {
+      ASSERT_TRUE(results[line]);
+      EXPECT_EQ(*(*results[line])["line"].number(), static_cast<double>(line));
+    }
+  }
+
+  std::vector<std::atomic<int>> seen(Lines);
+  std::atomic<size_t> errors{0};
+  json::forEachLine(
+      source,
+      [&](size_t line, json::Status status, const json::Json& json) {
+        if (status != json::Status::Ok) {
+          ++errors;
+        } else if (json["line"].number() == static_cast<double>(line)) {
+          ++seen[line];
+        }
+      },
+      {}, 4);
+  EXPECT_EQ(errors.load(), Lines / 1000);
+  for (size_t line = 0; line != Lines; ++line)
+    EXPECT_EQ(seen[line].load(), line % 1000 == 999 ? 0 : 1);
+}
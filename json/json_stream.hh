@@ -0,0 +1,63 @@
+#ifndef JSON_STREAM_HH
+#define JSON_STREAM_HH
+
+#include <cstdint>
+#include <string_view>
+
+#include "json/json.hh"
+#include "json/parse_options.hh"
+#include "json/parser.hh"
+#include "json/status.hh"
+
+namespace json {
+
+// Parses a document that arrives in pieces, e.g. from a socket or a pipe,
+// without collecting the whole input first:
+//
+//   json::JsonStream stream;
+//   while (read(chunk)) {
+//     if (auto status = stream.feed(chunk); status != json::Status::Ok) ...
+//   }
+//   auto json = stream.finish();
+//
+// Chunks may split tokens anywhere and need not outlive feed(). Strings and
+// names are always copied into the document, so ParseOptions::borrow_source
+// and ParseOptions::structural_index have no effect here.
+template <typename Index>
+class BasicJsonStream {
+  internal::Parser<Index> parser_;
+  ParseOptions options_;
+  Status status_{Status::Ok};
+
+ public:
+  explicit BasicJsonStream(const ParseOptions& options = {})
+      : parser_{internal::StringStorage::Copy, options.memory_resource},
+        options_{options} {}
+
+  // After an error, further input is ignored and the error is returned
+  // again, including from finish().
+  [[nodiscard]] auto feed(std::string_view chunk) -> Status {
+    if (status_ == Status::Ok) status_ = parser_.feed(chunk);
+    return status_;
+  }
+
+  // Returns the document and prepares the stream for the next one.
+  [[nodiscard]] auto finish() -> StatusOr<BasicJson<Index>> {
+    auto status = status_ == Status::Ok ? parser_.finish() : status_;
+    BasicJson<Index> json{options_.memory_resource};
+    json.setTape(parser_.takeTape());
+    parser_.reset(internal::Tape<Index>{options_.memory_resource},
+                  internal::StringStorage::Copy);
+    status_ = Status::Ok;
+
+    if (status != Status::Ok) return status;
+    json.indexKeys(options_);
+    return json;
+  }
+};
+
+using JsonStream = BasicJsonStream<uint32_t>;
+
+}  // namespace json
+
+#endif  // JSON_STREAM_HH
@@ -0,0 +1,68 @@
+#include <string>
+#include <string_view>
+
+#include "json/json_stream.hh"
+#include "json/parser.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+constexpr std::string_view Document =
+    R"({"name": "a \"quoted\\\\\" name", "values": [12, -3.5e+2, true, false,
+        null, "é"], "nested": {"empty": {}, "list": [[], [1]]}})";
+
+}  // namespace
+
+TEST(JsonStream_SplitsTokensAnywhere) {
+  json::internal::Parser<> whole;
+  ASSERT_EQ(whole.parse(Document), json::Status::Ok);
+
+  for (size_t split = 0; split <= Document.size(); ++split) {
+    for (size_t second = split; second <= Document.size(); ++second) {
+      json::internal::Parser<> streamed;
+      EXPECT_EQ(streamed.feed(Document.substr(0, split)), json::Status::Ok);
+      EXPECT_EQ(streamed.feed(Document.substr(split, second - split)),
+                json::Status::Ok);
+      EXPECT_EQ(streamed.feed(Document.substr(second)), json::Status::Ok);
+      EXPECT_EQ(streamed.finish(), json::Status::Ok);
+      EXPECT_TRUE(streamed.tape() == whole.tape());
+    }
+  }
+}
+
+TEST(JsonStream_ReportsErrorsLikeWholeDocuments) {
+  for (const std::string_view doc :
+       {"[1, 2 3]", "[tru]", "[truex]", "[1.]", "[\"open", "{\"a\" 1}"}) {
+    json::internal::Parser<> whole;
+    const auto expected = whole.parse(doc);
+    EXPECT_NE(expected, json::Status::Ok);
+
+    for (size_t split = 0; split <= doc.size(); ++split) {
+      json::internal::Parser<> streamed;
+      auto status = streamed.feed(doc.substr(0, split));
+      if (status == json::Status::Ok) status = streamed.feed(doc.substr(split));
+      if (status == json::Status::Ok) status = streamed.finish();
+      EXPECT_EQ(status, expected);
+    }
+  }
+}
+
+TEST(JsonStream_BuildsDocuments) {
+  json::JsonStream stream({.key_index_threshold = 1});
+  EXPECT_EQ(stream.feed(R"({"a": [1, 2], "b": "te)"), json::Status::Ok);
+  EXPECT_EQ(stream.feed(R"(xt"})"), json::Status::Ok);
+  auto json = stream.finish();
+  ASSERT_TRUE(json);
+  EXPECT_EQ(*(*json)["a"][1].number(), 2);
+  EXPECT_EQ(*(*json)["b"].string(), "text");
+
+  EXPECT_NE(stream.feed("[1 2]"), json::Status::Ok);
+  EXPECT_NE(stream.feed("]"), json::Status::Ok);
+  EXPECT_FALSE(stream.finish());
+
+  EXPECT_EQ(stream.feed("3"), json::Status::Ok);
+  EXPECT_EQ(stream.feed("4"), json::Status::Ok);
+  auto number = stream.finish();
+  ASSERT_TRUE(number);
+  EXPECT_EQ(*number->begin().number(), 34);
+}
@@ -1,3 +1,5 @@
+#include <cstdint>
+#include <string>
 #include <variant>
 
 #include "json/json.hh"
@@ -21,7 +23,10 @@ TEST(Json_ParsesConstantValues) {
 }
 
 TEST(Json_ParsesEmptyValues) {
-  ASSERT_TRUE(json::Json::parse(""));
+  auto empty = json::Json::parse("");
+  ASSERT_TRUE(empty);
+  ASSERT_TRUE(std::holds_alternative<json::Null>(empty->value()));
+  ASSERT_TRUE(std::holds_alternative<json::Null>(empty->end().value()));
 
   auto empty_string = json::Json::parse(R"("")");
   ASSERT_TRUE(empty_string);
@@ -42,6 +47,8 @@ TEST(Json_ParsesSimpleObject) {
   ASSERT_TRUE(std::holds_alternative<json::Object>(simple->value()));
   ASSERT_TRUE(std::holds_alternative<json::String>((*simple)["Hello"].value()));
   EXPECT_EQ(*(*simple)["Hello"].string(), "Object");
+  ASSERT_TRUE(std::holds_alternative<json::Null>((*simple)["x"].value()));
+  ASSERT_TRUE(std::holds_alternative<json::Null>(simple->end().value()));
 }
 
 TEST(Json_ParsesNumber) {
@@ -57,4 +64,124 @@ TEST(Json_KnowsWhatItHas) {
   ASSERT_FALSE(simple->has("World"));
   ASSERT_TRUE((*simple)["Hello"].has("World"));
   ASSERT_FALSE((*simple)["Hello"].has("Earth"));
-}
\ No newline at end of file
+}
+
+TEST(Json_DecodesEscapedStrings) {
+  auto escaped = json::Json::parse(
+      R"({"Tab\tbed": "\"Quoted\" \\ \/ é 😀 \n"})");
+  ASSERT_TRUE(escaped);
+  ASSERT_TRUE(escaped->has("Tab\tbed"));
+  EXPECT_EQ(*escaped->begin().begin().name(), "Tab\tbed");
+  EXPECT_EQ(*(*escaped)["Tab\tbed"].string(),
+            "\"Quoted\" \\ / \xC3\xA9 \xF0\x9F\x98\x80 \n");
+  EXPECT_EQ(std::get<json::String>((*escaped)["Tab\tbed"].value()).value,
+            *(*escaped)["Tab\tbed"].string());
+
+  EXPECT_FALSE(json::Json::parse(R"("\x")"));
+  EXPECT_FALSE(json::Json::parse(R"("\u12")"));
+  EXPECT_FALSE(json::Json::parse(R"({"\q": 1})"));
+}
+
+TEST(Json_BorrowsStringsFromTheSource) {
+  const std::string source = R"({"Hello": "World"})";
+
+  auto owned = json::Json::parse(source);
+  ASSERT_TRUE(owned);
+  auto owned_name = *(*owned)["Hello"].name();
+  EXPECT_FALSE(owned_name.data() >= source.data() &&
+               owned_name.data() < source.data() + source.size());
+
+  auto borrowed = json::Json::parse(source, {.borrow_source = true});
+  ASSERT_TRUE(borrowed);
+  auto borrowed_name = *(*borrowed)["Hello"].name();
+  auto borrowed_value = *(*borrowed)["Hello"].string();
+  EXPECT_EQ(borrowed_name.data(), source.data() + 2);
+  EXPECT_EQ(borrowed_value.data(), source.data() + 11);
+  EXPECT_EQ(borrowed_value, "World");
+}
+
+TEST(Json_SkipsNestedContainers) {
+  auto nested = json::Json::parse(R"({"a": [1, [2, 3], {"b": 4}], "c": 5})");
+  ASSERT_TRUE(nested);
+  EXPECT_EQ(*(*nested)["c"].number(), 5);
+  EXPECT_EQ(*(*nested)["a"][2]["b"].number(), 4);
+  EXPECT_EQ(*(*nested)["a"][1][1].number(), 3);
+
+  auto unclosed = json::Json::parse(R"([[1, 2], [3)");
+  ASSERT_TRUE(unclosed);
+  EXPECT_EQ(*(*unclosed).begin()[1][0].number(), 3);
+}
+
+TEST(Json_SupportsWideTapeIndices) {
+  auto wide = json::BasicJson<uint64_t>::parse(R"({"a": [1, "two", null]})");
+  ASSERT_TRUE(wide);
+  EXPECT_EQ(*(*wide)["a"][1].string(), "two");
+  EXPECT_TRUE(std::holds_alternative<json::Null>((*wide)["a"][2].value()));
+}
+
+TEST(Json_IgnoresTrailingNameWithoutValue) {
+  auto truncated = json::Json::parse(R"({"a": 1, "b")");
+  ASSERT_TRUE(truncated);
+  EXPECT_EQ(*(*truncated)["a"].number(), 1);
+  EXPECT_FALSE(truncated->has("b"));
+}
+
+TEST(Json_IndexesLargeObjects) {
+  const std::string source =
+      R"({"a": 1, "b": {"x": true, "y": false}, "c\u0041": 3, "a": 4,
+          "d": {"z": null}})";
+  for (const bool borrow : {false, true}) {
+    auto json = json::Json::parse(
+        source, {.borrow_source = borrow, .key_index_threshold = 2});
+    ASSERT_TRUE(json);
+    EXPECT_EQ(*(*json)["a"].number(), 1);
+    EXPECT_EQ(*(*json)["cA"].number(), 3);
+    EXPECT_EQ(*(*json)["b"]["y"].boolean(), false);
+    EXPECT_TRUE((*json)["d"].has("z"));
+    EXPECT_FALSE((*json)["d"].has("y"));
+    EXPECT_FALSE(json->has("e"));
+    EXPECT_FALSE(json->has("c\\u0041"));
+  }
+}
+
+TEST(Json_IndexesArrayElements) {
+  auto json = json::Json::parse(
+      R"({"scalars": [1, 2, 3], "mixed": [[1, 2], 3, {"a": 4, "b": [5]}, 6],
+          "empty": []})");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->begin().size(), 3U);
+  EXPECT_EQ((*json)["scalars"].size(), 3U);
+  EXPECT_EQ((*json)["mixed"].size(), 4U);
+  EXPECT_EQ((*json)["mixed"][2].size(), 2U);
+  EXPECT_EQ((*json)["empty"].size(), 0U);
+  EXPECT_EQ((*json)["mixed"][0][1].size(), 0U);
+
+  EXPECT_EQ(*(*json)["scalars"][2].number(), 3);
+  EXPECT_EQ(*(*json)["mixed"][1].number(), 3);
+  EXPECT_EQ(*(*json)["mixed"][2]["b"][0].number(), 5);
+  EXPECT_EQ(*(*json)["mixed"][3].number(), 6);
+  EXPECT_TRUE((*json)["mixed"][4] == json->end());
+  EXPECT_TRUE((*json)["empty"][0] == json->end());
+  EXPECT_EQ(*json->begin()[1][0][0].number(), 1);
+
+  auto unclosed = json::Json::parse(R"([[1], {"a": 2}, [3)");
+  ASSERT_TRUE(unclosed);
+  EXPECT_EQ(unclosed->begin().size(), 3U);
+  EXPECT_EQ(*unclosed->begin()[2][0].number(), 3);
+}
+
+TEST(Json_KeepsIntegersExact) {
+  auto json = json::Json::parse(
+      R"({"id": 9007199254740993, "big": 18446744073709551615, "neg": -5,)"
+      R"( "real": 2.5})");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(*(*json)["id"].integer(), 9007199254740993);
+  EXPECT_EQ(*(*json)["big"].uint64(), 18446744073709551615U);
+  EXPECT_FALSE((*json)["big"].integer());
+  EXPECT_FALSE((*json)["neg"].uint64());
+  EXPECT_FALSE((*json)["real"].integer());
+  EXPECT_EQ(*(*json)["neg"].number(), -5);
+  EXPECT_TRUE((*json)["id"].value() ==
+              json::Value{json::Integer{9007199254740993}});
+  EXPECT_TRUE((*json)["real"].value() == json::Value{json::Number{2.5}});
+}
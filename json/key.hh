@@ -0,0 +1,65 @@
+#ifndef KEY_HH
+#define KEY_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "json/key_index.hh"
+
+namespace json {
+
+// A member name known at compile time, with its length and hash computed
+// then. Looking it up skips members by the length of their name before
+// comparing any text, and indexed objects by the precomputed hash:
+//
+//   using namespace json::literals;
+//   auto name = (*json)["user"_key]["name"_key].string();
+//
+class Key {
+  std::string_view name_;
+  uint64_t hash_;
+
+ public:
+  explicit consteval Key(std::string_view name)
+      : name_{name}, hash_{internal::hashKey(name)} {}
+
+  [[nodiscard]] constexpr auto name() const -> std::string_view {
+    return name_;
+  }
+
+  [[nodiscard]] constexpr auto hash() const -> uint64_t { return hash_; }
+};
+
+namespace internal {
+
+// A string literal as template argument, for get<"name">().
+template <size_t N>
+struct KeyLiteral {
+  std::array<char, N> chars{};
+
+  // NOLINTNEXTLINE(*-avoid-c-arrays, google-explicit-constructor)
+  consteval KeyLiteral(const char (&literal)[N]) {
+    std::copy_n(literal, N, chars.begin());
+  }
+
+  [[nodiscard]] constexpr auto name() const -> std::string_view {
+    return {chars.data(), N - 1};
+  }
+};
+
+}  // namespace internal
+
+namespace literals {
+
+consteval auto operator""_key(const char* name, size_t size) -> Key {
+  return Key{std::string_view{name, size}};
+}
+
+}  // namespace literals
+
+}  // namespace json
+
+#endif  // KEY_HH
@@ -0,0 +1,138 @@
+#ifndef KEY_INDEX_HH
+#define KEY_INDEX_HH
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "json/tape.hh"
+
+//
+// Hash tables over the member names of large objects, so that looking up a
+// member does not have to compare every name before it.
+//
+// Tables use open addressing with linear probing and are at most half full.
+// All tables of a document share one slot array; an indexed object refers to
+// its table by offset (TapeEntry::table()), and the table's capacity
+// follows from the object's member count.
+//
+
+namespace json::internal {
+
+// FNV-1a. Cheap on the short names typical for JSON, and usable in constant
+// expressions.
+[[nodiscard]] constexpr auto hashKey(std::string_view key) -> uint64_t {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const char chr : key) {
+    hash ^= static_cast<unsigned char>(chr);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+template <typename Index>
+class KeyIndex {
+ public:
+  struct Slot {
+    // Upper half of the hash. The lower bits pick the slot.
+    uint32_t tag;
+    // Tape index of the member's Key entry. 0 marks an empty slot; the first
+    // entry of a document is never a key.
+    Index key;
+  };
+
+ private:
+  std::pmr::vector<Slot> slots_;
+  // Tables built elsewhere, used instead of slots_ if not empty.
+  std::span<const Slot> loaded_;
+
+  [[nodiscard]] static auto capacity(const TapeEntry<Index>& object)
+      -> size_t {
+    return std::bit_ceil(size_t{object.count()} * 2);
+  }
+
+  [[nodiscard]] static auto tag(uint64_t hash) -> uint32_t {
+    return static_cast<uint32_t>(hash >> 32);
+  }
+
+ public:
+  KeyIndex() = default;
+
+  explicit KeyIndex(std::pmr::memory_resource* resource) : slots_{resource} {}
+
+  void clear() {
+    slots_.clear();
+    loaded_ = {};
+  }
+
+  // Uses the tables in `slots`, which must outlive the index, as they were
+  // built for the same tape.
+  void load(std::span<const Slot> slots) {
+    clear();
+    loaded_ = slots;
+  }
+
+  [[nodiscard]] auto slots() const -> std::span<const Slot> {
+    if (!loaded_.empty()) return loaded_;
+    return slots_;
+  }
+
+  // Indexes every object of `tape` with at least `threshold` members.
+  // `text(idx)` returns the name of the Key entry at tape index `idx`.
+  template <typename Text>
+  void build(Tape<Index>& tape, size_t threshold, const Text& text) {
+    clear();
+    auto& entries = tape.entries;
+    for (size_t object = 0; object != entries.size(); ++object) {
+      auto& entry = entries[object];
+      if (entry.type() != EntryType::Object || entry.count() == 0 ||
+          entry.count() < threshold)
+        continue;
+
+      const auto offset = slots_.size();
+      const auto mask = capacity(entry) - 1;
+      slots_.resize(offset + mask + 1);
+      entry.setTable(static_cast<Index>(offset + 1));
+
+      // Members are inserted in document order, so of several members with
+      // the same name, the first one is found first.
+      const auto end = object + 1 + entry.size();
+      for (size_t key = object + 1; key < end;
+           key += 2 + entries[key + 1].size()) {
+        const auto hash = hashKey(text(key));
+        auto pos = hash & mask;
+        while (slots_[offset + pos].key != 0) pos = (pos + 1) & mask;
+        slots_[offset + pos] = Slot{tag(hash), static_cast<Index>(key)};
+      }
+    }
+  }
+
+  // Returns the tape index of the Key entry named `key` in the indexed
+  // `object`, or 0 if there is no such member.
+  template <typename Text>
+  [[nodiscard]] auto find(const TapeEntry<Index>& object, std::string_view key,
+                          const Text& text) const -> size_t {
+    return find(object, key, hashKey(key), text);
+  }
+
+  // As above, with the name's hashKey() computed ahead of time.
+  template <typename Text>
+  [[nodiscard]] auto find(const TapeEntry<Index>& object, std::string_view key,
+                          uint64_t hash, const Text& text) const -> size_t {
+    const auto* table = slots().data() + object.table() - 1;
+    const auto mask = capacity(object) - 1;
+    for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+      const auto& slot = table[pos];
+      if (slot.key == 0) return 0;
+      if (slot.tag == tag(hash) && text(slot.key) == key) return slot.key;
+    }
+  }
+};
+
+}  // namespace json::internal
+
+#endif  // KEY_INDEX_HH
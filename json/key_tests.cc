@@ -0,0 +1,49 @@
+#include <cstdint>
+#include <string_view>
+
+#include "json/json.hh"
+#include "json/key.hh"
+#include "testrunner/testrunner.h"
+
+using namespace json::literals;
+
+TEST(Key_IsComputedAtCompileTime) {
+  constexpr auto key = "user"_key;
+  static_assert(key.name() == "user");
+  static_assert(key.hash() == json::internal::hashKey("user"));
+  EXPECT_EQ(key.name().size(), 4U);
+}
+
+TEST(Key_LooksUpMembers) {
+  constexpr std::string_view Source =
+      R"({"us": 1, "user": {"name": "n", "id": 7}, "usr": 2, "a\nb": 3})";
+  for (const auto borrow : {false, true}) {
+    for (const auto threshold : {0U, 1U}) {
+      const auto json = json::Json::parse(
+          Source, {.borrow_source = borrow, .key_index_threshold = threshold});
+      ASSERT_TRUE(json);
+      EXPECT_EQ((*json)["user"_key]["name"_key].string(),
+                std::string_view{"n"});
+      EXPECT_EQ((*json)["us"_key].integer(), int64_t{1});
+      EXPECT_EQ((*json)["a\nb"_key].integer(), int64_t{3});
+      EXPECT_TRUE((*json)["use"_key] == json->end());
+      EXPECT_TRUE((*json)["user"_key]["user"_key] == json->end());
+
+      EXPECT_EQ((json->get<"user", "id">().integer()), int64_t{7});
+      EXPECT_EQ(json->get<"usr">().integer(), int64_t{2});
+      EXPECT_TRUE((json->get<"user", "missing", "deeper">() == json->end()));
+      EXPECT_TRUE(json->get<>() == json->begin());
+    }
+  }
+}
+
+TEST(Key_FindsNothingInEmptyDocumentsAndScalars) {
+  const auto empty = json::Json::parse("");
+  ASSERT_TRUE(empty);
+  EXPECT_TRUE(empty->get<"a">() == empty->end());
+  EXPECT_TRUE((*empty)["a"_key] == empty->end());
+
+  const auto array = json::Json::parse(R"(["a", {"a": 1}])");
+  ASSERT_TRUE(array);
+  EXPECT_TRUE((*array)["a"_key] == array->end());
+}
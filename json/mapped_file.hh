@@ -0,0 +1,87 @@
+#ifndef MAPPED_FILE_HH
+#define MAPPED_FILE_HH
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#include "json/status.hh"
+
+namespace json::internal {
+
+// A file mapped read only into memory, unmapped on destruction. Documents
+// parse straight from the mapping, without copying the file into a buffer
+// first.
+class MappedFile {
+  void* data_{};
+  size_t size_{};
+
+  MappedFile(void* data, size_t size) : data_{data}, size_{size} {}
+
+ public:
+  MappedFile() = default;
+
+  MappedFile(MappedFile&& other) noexcept
+      : data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  ~MappedFile() {
+    if (data_ != nullptr) ::munmap(data_, size_);
+  }
+
+  // Only regular files can be mapped; use JsonStream for pipes and sockets.
+  [[nodiscard]] static auto open(const std::filesystem::path& path)
+      -> StatusOr<MappedFile> {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return Status::CannotReadFile;
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+      ::close(fd);
+      return Status::CannotReadFile;
+    }
+
+    // Empty files cannot be mapped, but are empty documents all the same.
+    const auto size = static_cast<size_t>(info.st_size);
+    if (size == 0) {
+      ::close(fd);
+      return MappedFile{};
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return Status::CannotReadFile;
+
+    // The parser reads the file front to back exactly once. The hints are
+    // only advice; failures are ignored.
+    ::madvise(data, size, MADV_SEQUENTIAL);
+    ::madvise(data, size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    ::madvise(data, size, MADV_HUGEPAGE);
+#endif
+    return MappedFile{data, size};
+  }
+
+  [[nodiscard]] auto contents() const -> std::string_view {
+    return {static_cast<const char*>(data_), size_};
+  }
+};
+
+}  // namespace json::internal
+
+#endif  // MAPPED_FILE_HH
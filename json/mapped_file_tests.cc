@@ -0,0 +1,55 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "json/json.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+auto writeFile(std::string_view name, std::string_view contents)
+    -> std::filesystem::path {
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream{path, std::ios::binary} << contents;
+  return path;
+}
+
+}  // namespace
+
+TEST(MappedFile_ParsesFiles) {
+  for (const bool borrow : {false, true}) {
+    const auto path =
+        writeFile("json_mapped_file_test.json",
+                  R"({"name": "mapped \"file\"", "list": [1, 2]})");
+    auto json = json::Json::parseFile(path, {.borrow_source = borrow});
+    ASSERT_TRUE(json);
+
+    // Borrowed strings stay valid after the file is gone, and after the
+    // document moved.
+    std::filesystem::remove(path);
+    const auto moved = std::move(*json);
+    EXPECT_EQ(*moved["name"].string(), "mapped \"file\"");
+    EXPECT_EQ(*moved["list"][1].number(), 2);
+  }
+}
+
+TEST(MappedFile_ReportsUnreadableFiles) {
+  const auto empty = writeFile("json_mapped_file_empty.json", "");
+  auto json = json::Json::parseFile(empty);
+  ASSERT_TRUE(json);
+  EXPECT_TRUE(json->begin() == json->end());
+  std::filesystem::remove(empty);
+
+  EXPECT_EQ(json::Json::parseFile(empty).status(),
+            json::Status::CannotReadFile);
+  EXPECT_EQ(
+      json::Json::parseFile(std::filesystem::temp_directory_path()).status(),
+      json::Status::CannotReadFile);
+
+  const auto broken = writeFile("json_mapped_file_broken.json", "[1 2]");
+  EXPECT_EQ(json::Json::parseFile(broken).status(),
+            json::Status::UnexpectedToken);
+  std::filesystem::remove(broken);
+}
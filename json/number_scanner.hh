@@ -0,0 +1,239 @@
+#ifndef NUMBER_SCANNER_HH
+#define NUMBER_SCANNER_HH
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include "json/character_utils.hh"
+
+//
+// Numbers are validated and converted in a single pass over their text.
+//
+// Integers that fit 64 bits are kept exact. Everything else becomes a
+// double: exactly when the decimal significand and the power of ten are
+// small enough for one correctly rounded floating point operation (Clinger,
+// "How to Read Floating Point Numbers Accurately", 1990), and through
+// std::from_chars otherwise.
+//
+
+namespace json::internal {
+
+// A number as scanned from its text: exact if it is an integer that fits
+// int64_t (or uint64_t, above that), a double otherwise.
+struct ScannedNumber {
+  enum class Kind : uint8_t { Integer, UInt64, Double };
+
+  Kind kind = Kind::Double;
+  // The bits of the int64_t, uint64_t or double, depending on kind.
+  uint64_t bits = 0;
+
+  [[nodiscard]] static constexpr auto makeInteger(int64_t value)
+      -> ScannedNumber {
+    return {Kind::Integer, std::bit_cast<uint64_t>(value)};
+  }
+
+  [[nodiscard]] static constexpr auto makeUInt64(uint64_t value)
+      -> ScannedNumber {
+    return {Kind::UInt64, value};
+  }
+
+  [[nodiscard]] static constexpr auto makeDouble(double value)
+      -> ScannedNumber {
+    return {Kind::Double, std::bit_cast<uint64_t>(value)};
+  }
+
+  [[nodiscard]] constexpr auto integer() const -> int64_t {
+    return std::bit_cast<int64_t>(bits);
+  }
+
+  [[nodiscard]] constexpr auto uint64() const -> uint64_t { return bits; }
+
+  // Any number, rounded to the nearest double if necessary.
+  [[nodiscard]] constexpr auto real() const -> double {
+    switch (kind) {
+      case Kind::Integer:
+        return static_cast<double>(integer());
+      case Kind::UInt64:
+        return static_cast<double>(uint64());
+      case Kind::Double:
+        break;
+    }
+    return std::bit_cast<double>(bits);
+  }
+
+  auto operator==(const ScannedNumber&) const -> bool = default;
+};
+
+// SWAR digit handling, eight characters per 64 bit word (Lemire, "Fast
+// numerical parsing", 2020). Only used on little endian machines, where the
+// first character is the lowest byte.
+[[nodiscard]] inline auto loadEightCharacters(const char* chars) -> uint64_t {
+  uint64_t word{};
+  std::memcpy(&word, chars, sizeof(word));
+  return word;
+}
+
+[[nodiscard]] constexpr auto isEightDigits(uint64_t word) -> bool {
+  return ((word & 0xF0F0F0F0F0F0F0F0) |
+          (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+[[nodiscard]] constexpr auto parseEightDigits(uint64_t word) -> uint64_t {
+  word = ((word & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+  word = ((word & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+  return ((word & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+}
+
+// Accumulates the digits starting at `pos` into `value`. Values of more than
+// 19 digits wrap around; callers check the digit count.
+[[nodiscard]] inline auto scanDigits(const char* pos, const char* end,
+                                     uint64_t& value) -> const char* {
+  if constexpr (std::endian::native == std::endian::little) {
+    while (end - pos >= 8) {
+      const auto word = loadEightCharacters(pos);
+      if (!isEightDigits(word)) break;
+      value = value * 100000000 + parseEightDigits(word);
+      pos += 8;
+    }
+  }
+  while (pos != end && isDigit(*pos)) {
+    value = value * 10 + static_cast<uint64_t>(*pos - '0');
+    ++pos;
+  }
+  return pos;
+}
+
+// Powers of ten that are exact doubles.
+inline constexpr auto ExactPowersOfTen = [] {
+  std::array<double, 23> powers{};
+  double power = 1;
+  for (auto& entry : powers) {
+    entry = power;
+    power *= 10;
+  }
+  return powers;
+}();
+
+// Scans the number at the start of `str` into `number`. Returns the length
+// of the number, or 0 if `str` does not start with one.
+//
+//" 8 Numbers
+//"
+//" A number is a sequence of decimal digits with no superfluous leading
+//" zero. It may have a preceding minus sign (U+002D). It may have a
+//" fractional part prefixed by a decimal point (U+002E). It may have an
+//" exponent, prefixed by e (U+0065) or E (U+0045) and optionally + (U+002B)
+//" or - (U+002D).
+//
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+[[nodiscard]] inline auto scanNumber(std::string_view str,
+                                     ScannedNumber& number) -> size_t {
+  const char* const begin = str.data();
+  const char* const end = begin + str.size();
+  const char* pos = begin;
+
+  const bool negative = pos != end && *pos == '-';
+  if (negative) ++pos;
+  if (pos == end || !isDigit(*pos)) return 0;
+
+  uint64_t significand = 0;
+  const char* const integer_part = pos;
+  if (*pos == '0') {
+    ++pos;
+    if (pos != end && isDigit(*pos)) return 0;
+  } else {
+    pos = scanDigits(pos, end, significand);
+  }
+  const auto integer_digits = pos - integer_part;
+
+  bool is_integer = true;
+  int64_t exponent = 0;
+  if (pos != end && *pos == '.') {
+    is_integer = false;
+    const char* const fraction = ++pos;
+    pos = scanDigits(pos, end, significand);
+    if (pos == fraction) return 0;
+    exponent = fraction - pos;
+  }
+  const auto digits = integer_digits - (is_integer ? 0 : exponent);
+
+  if (pos != end && (*pos == 'e' || *pos == 'E')) {
+    is_integer = false;
+    ++pos;
+    const bool negative_exponent = pos != end && *pos == '-';
+    if (pos != end && (*pos == '+' || *pos == '-')) ++pos;
+    if (pos == end || !isDigit(*pos)) return 0;
+
+    int64_t explicit_exponent = 0;
+    for (; pos != end && isDigit(*pos); ++pos) {
+      // Far beyond the range of doubles either way.
+      if (explicit_exponent < 100000)
+        explicit_exponent = explicit_exponent * 10 + (*pos - '0');
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+  const auto length = static_cast<size_t>(pos - begin);
+
+  // The text of 20 digit integers is compared instead of checking every
+  // step for overflow.
+  constexpr std::string_view MaxUInt64 = "18446744073709551615";
+  const bool exact =
+      digits <= 19 ||
+      (digits == 20 && is_integer &&
+       std::string_view{integer_part, MaxUInt64.size()} <= MaxUInt64);
+
+  if (is_integer && exact) {
+    constexpr auto MaxInteger =
+        static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (!negative && significand <= MaxInteger) {
+      number = ScannedNumber::makeInteger(static_cast<int64_t>(significand));
+      return length;
+    }
+    if (!negative) {
+      number = ScannedNumber::makeUInt64(significand);
+      return length;
+    }
+    // -0 is kept as a double, which has a sign for zero.
+    if (significand != 0 && significand <= MaxInteger + 1) {
+      number = ScannedNumber::makeInteger(
+          std::bit_cast<int64_t>(uint64_t{0} - significand));
+      return length;
+    }
+  }
+
+  constexpr uint64_t MaxExactSignificand = uint64_t{1} << 53;
+  constexpr auto MaxExactPower =
+      static_cast<int64_t>(ExactPowersOfTen.size() - 1);
+  if (digits <= 19 && significand <= MaxExactSignificand &&
+      exponent >= -MaxExactPower && exponent <= MaxExactPower) {
+    auto value = static_cast<double>(significand);
+    if (exponent < 0) {
+      value /= ExactPowersOfTen[static_cast<size_t>(-exponent)];
+    } else {
+      value *= ExactPowersOfTen[static_cast<size_t>(exponent)];
+    }
+    number = ScannedNumber::makeDouble(negative ? -value : value);
+    return length;
+  }
+
+  double value{};
+  std::from_chars(begin, pos, value);
+  number = ScannedNumber::makeDouble(value);
+  return length;
+}
+
+// The number at the start of `str`, or nothing if there is none.
+inline auto extractNumber(std::string_view str) -> std::string_view {
+  ScannedNumber number;
+  return str.substr(0, scanNumber(str, number));
+}
+
+}  // namespace json::internal
+
+#endif  // NUMBER_SCANNER_HH
@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "json/number_scanner.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+auto scan(std::string_view text) -> json::internal::ScannedNumber {
+  json::internal::ScannedNumber number;
+  (void)json::internal::scanNumber(text, number);
+  return number;
+}
+
+}  // namespace
+
+TEST(NumberScanner_KeepsIntegersExact) {
+  using Kind = json::internal::ScannedNumber::Kind;
+
+  EXPECT_EQ(scan("12345678901234567").integer(), 12345678901234567);
+  EXPECT_EQ(scan("-9223372036854775808").integer(),
+            std::numeric_limits<int64_t>::min());
+  EXPECT_TRUE(scan("9223372036854775807").kind == Kind::Integer);
+
+  const auto large = scan("18446744073709551615");
+  EXPECT_TRUE(large.kind == Kind::UInt64);
+  EXPECT_EQ(large.uint64(), std::numeric_limits<uint64_t>::max());
+
+  // Out of range integers and -0 become doubles.
+  EXPECT_TRUE(scan("18446744073709551616").kind == Kind::Double);
+  EXPECT_TRUE(scan("-9223372036854775809").kind == Kind::Double);
+  EXPECT_TRUE(scan("-0").kind == Kind::Double);
+  EXPECT_TRUE(scan("1.0").kind == Kind::Double);
+}
+
+TEST(NumberScanner_ConvertsRealNumbers) {
+  EXPECT_EQ(scan("0.1").real(), 0.1);
+  EXPECT_EQ(scan("-12.5e-1").real(), -1.25);
+  EXPECT_EQ(scan("1E22").real(), 1e22);
+  EXPECT_EQ(scan("1e23").real(), 1e23);
+  EXPECT_EQ(scan("3.14159265358979323846264").real(), 3.141592653589793);
+  EXPECT_EQ(scan("123456789012345678901234567890").real(),
+            1.2345678901234568e29);
+
+  json::internal::ScannedNumber number;
+  EXPECT_EQ(json::internal::scanNumber("-12.5e-1", number), 8);
+  EXPECT_EQ(json::internal::scanNumber("1.5e", number), 0);
+  EXPECT_EQ(json::internal::scanNumber("012", number), 0);
+  EXPECT_EQ(json::internal::scanNumber("12345678.9, 1", number), 10);
+}
@@ -0,0 +1,429 @@
+#ifndef ON_DEMAND_HH
+#define ON_DEMAND_HH
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "json/character_utils.hh"
+#include "json/status.hh"
+#include "json/structural_index.hh"
+#include "json/token.hh"
+#include "json/tokenizer.hh"
+#include "json/unescaped_strings.hh"
+#include "json/value.hh"
+
+//
+// Lazy navigation of a document without building a tape.
+//
+// Parsing only builds the structural index and checks that its tokens form
+// one complete value, noting where every container ends on the way. Values
+// are positions in the index: numbers, literal names and strings are decoded
+// when read, and containers the caller steps over are skipped in one jump.
+//
+// Unlike Json::parse(), the contents of numbers, literal names and strings
+// are therefore only checked when they are read. A value that does not
+// decode reads as std::nullopt (or Null from value()). Containers must also
+// be closed; Json::parse() closes the ones left open at the end.
+//
+
+namespace json {
+
+namespace internal {
+
+// Checks that the tokens at `positions` form exactly one complete value.
+// Only the first byte of numbers and literal names is looked at. For every
+// opening bracket, `closing` receives the index of the matching one.
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+[[nodiscard]] inline auto checkStructure(std::string_view source,
+                                         const std::vector<uint32_t>& positions,
+                                         std::vector<uint32_t>& closing)
+    -> Status {
+  enum class Expect { Value, ValueOrEnd, NameOrEnd, Name, Colon, CommaOrEnd };
+
+  closing.resize(positions.size());
+  // Indices of the opening brackets of the open containers.
+  std::vector<uint32_t> containers;
+  auto expect = Expect::Value;
+  bool complete = positions.empty();
+  const auto expectsValue = [&] {
+    return !complete &&
+           (expect == Expect::Value || expect == Expect::ValueOrEnd);
+  };
+  const auto endValue = [&] {
+    expect = Expect::CommaOrEnd;
+    complete = containers.empty();
+  };
+
+  for (size_t idx = 0; idx != positions.size(); ++idx) {
+    const auto chr = source[positions[idx]];
+    switch (chr) {
+      case '"':
+        // Both quotation marks are indexed.
+        if (++idx == positions.size()) return Status::UnexpectedCharacter;
+        if (!complete &&
+            (expect == Expect::Name || expect == Expect::NameOrEnd)) {
+          expect = Expect::Colon;
+        } else if (expectsValue()) {
+          endValue();
+        } else {
+          return Status::UnexpectedToken;
+        }
+        break;
+
+      case '{':
+      case '[':
+        if (!expectsValue()) return Status::UnexpectedToken;
+        containers.push_back(static_cast<uint32_t>(idx));
+        expect = chr == '{' ? Expect::NameOrEnd : Expect::ValueOrEnd;
+        break;
+
+      case '}':
+      case ']':
+        if (complete || containers.empty() ||
+            source[positions[containers.back()]] != (chr == '}' ? '{' : '['))
+          return Status::UnexpectedToken;
+        if (expect != Expect::CommaOrEnd &&
+            expect != (chr == '}' ? Expect::NameOrEnd : Expect::ValueOrEnd))
+          return Status::UnexpectedToken;
+        closing[containers.back()] = static_cast<uint32_t>(idx);
+        containers.pop_back();
+        endValue();
+        break;
+
+      case ',':
+        if (complete || expect != Expect::CommaOrEnd)
+          return Status::UnexpectedToken;
+        expect = source[positions[containers.back()]] == '{' ? Expect::Name
+                                                              : Expect::Value;
+        break;
+
+      case ':':
+        if (complete || expect != Expect::Colon) return Status::UnexpectedToken;
+        expect = Expect::Value;
+        break;
+
+      default:
+        switch (classify(chr)) {
+          case CharClass::Number:
+          case CharClass::LiteralTrue:
+          case CharClass::LiteralFalse:
+          case CharClass::LiteralNull:
+            break;
+          default:
+            return Status::UnexpectedCharacter;
+        }
+        if (!expectsValue()) return Status::UnexpectedToken;
+        endValue();
+        break;
+    }
+  }
+  return complete ? Status::Ok : Status::UnexpectedToken;
+}
+
+}  // namespace internal
+
+class OnDemand;
+
+// Refers to a value of an OnDemand document, with the interface of
+// ValueIterator. Object members are positioned on their name.
+class OnDemandIterator {
+ public:
+  [[nodiscard]] constexpr auto operator<=>(
+      const OnDemandIterator&) const noexcept = default;
+
+  [[nodiscard]] inline auto string() const -> std::optional<std::string_view>;
+  [[nodiscard]] inline auto number() const -> std::optional<double>;
+  [[nodiscard]] inline auto integer() const -> std::optional<int64_t>;
+  [[nodiscard]] inline auto uint64() const -> std::optional<uint64_t>;
+  [[nodiscard]] inline auto boolean() const -> std::optional<bool>;
+  [[nodiscard]] inline auto value() const -> Value;
+  [[nodiscard]] inline auto name() const -> std::optional<std::string_view>;
+
+  [[nodiscard]] auto operator*() const -> const OnDemandIterator& {
+    return *this;
+  }
+
+  [[nodiscard]] inline auto operator[](std::string_view key) const
+      -> OnDemandIterator;
+  [[nodiscard]] inline auto operator[](size_t offset) const
+      -> OnDemandIterator;
+  [[nodiscard]] inline auto has(std::string_view key) const -> bool;
+
+  // Number of members of an object or values of an array, 0 for anything
+  // else. Counting steps over every child.
+  [[nodiscard]] inline auto size() const -> size_t;
+
+  [[nodiscard]] inline auto begin() const -> OnDemandIterator;
+  [[nodiscard]] inline auto end() const -> OnDemandIterator;
+  inline auto operator++() -> OnDemandIterator&;
+
+ private:
+  friend OnDemand;
+  OnDemandIterator(const OnDemand* document, size_t idx)
+      : document_{document}, idx_{idx} {}
+
+  [[nodiscard]] inline auto valueIndex() const -> size_t;
+  [[nodiscard]] inline auto token() const -> std::optional<Token>;
+
+  const OnDemand* document_;
+  // Index into the document's structural positions.
+  size_t idx_;
+};
+
+// A document navigated in place. The source is not copied and has to
+// outlive the document.
+class OnDemand {
+ public:
+  using value_iterator = OnDemandIterator;
+
+  // An empty document, as parsed from "".
+  OnDemand() = default;
+
+  [[nodiscard]] static auto parse(std::string_view json_source)
+      -> StatusOr<OnDemand> {
+    if (!internal::StructuralIndex::fits(json_source))
+      return Status::DocumentTooLarge;
+
+    OnDemand document;
+    document.source_ = json_source;
+    document.index_.rebuild(json_source);
+    auto status = internal::checkStructure(
+        json_source, document.index_.positions(), document.closing_);
+    if (status != Status::Ok) return status;
+    return document;
+  }
+
+  [[nodiscard]] auto operator[](std::string_view key) const -> value_iterator {
+    return begin()[key];
+  }
+
+  [[nodiscard]] auto has(std::string_view key) const -> bool {
+    return (*this)[key] != end();
+  }
+
+  [[nodiscard]] auto begin() const -> value_iterator {
+    return OnDemandIterator{this, 0};
+  }
+
+  [[nodiscard]] auto end() const -> value_iterator {
+    return OnDemandIterator{this, positions().size()};
+  }
+
+  [[nodiscard]] auto value() const -> Value { return begin().value(); }
+
+ private:
+  friend value_iterator;
+
+  [[nodiscard]] auto positions() const -> const std::vector<uint32_t>& {
+    return index_.positions();
+  }
+
+  // First character of the token at index `idx`.
+  [[nodiscard]] auto at(size_t idx) const -> char {
+    return source_[positions()[idx]];
+  }
+
+  // Names are the strings followed by a colon.
+  [[nodiscard]] auto isName(size_t idx) const -> bool {
+    return at(idx) == '"' && idx + 2 < positions().size() &&
+           at(idx + 2) == ':';
+  }
+
+  // True at the closing bracket of a container or the end of the document.
+  [[nodiscard]] auto isEnd(size_t idx) const -> bool {
+    if (idx == positions().size()) return true;
+    const auto chr = at(idx);
+    return chr == '}' || chr == ']';
+  }
+
+  // Index of the token following the value at `idx`.
+  [[nodiscard]] auto skip(size_t idx) const -> size_t {
+    switch (at(idx)) {
+      case '"':
+        return idx + 2;
+      case '{':
+      case '[':
+        return closing_[idx] + size_t{1};
+      default:
+        return idx + 1;
+    }
+  }
+
+  // Index of the member or element following the value at `idx`, or of the
+  // closing bracket of the container.
+  [[nodiscard]] auto next(size_t idx) const -> size_t {
+    idx = skip(idx);
+    if (idx != positions().size() && at(idx) == ',') ++idx;
+    return idx;
+  }
+
+  // The decoded text of the string whose opening quotation mark is at `idx`.
+  [[nodiscard]] auto text(size_t idx) const
+      -> std::optional<std::string_view> {
+    const auto begin = positions()[idx] + size_t{1};
+    const auto text = source_.substr(begin, positions()[idx + 1] - begin);
+    if (text.find('\\') == std::string_view::npos) return text;
+    return unescaped_->decode(text);
+  }
+
+  // The number or literal name at `idx`, if it is a valid token and the only
+  // one up to the next indexed position.
+  [[nodiscard]] auto token(size_t idx) const -> std::optional<Token> {
+    const auto begin = positions()[idx];
+    const auto end =
+        idx + 1 == positions().size() ? source_.size() : positions()[idx + 1];
+    auto rest = source_.substr(begin, end - begin);
+    auto token = internal::Tokenizer::parse(rest);
+    if (!token) return std::nullopt;
+    const auto trailing = internal::Tokenizer::parse(rest);
+    if (trailing || trailing.status() != Status::Ok) return std::nullopt;
+    return *token;
+  }
+
+  std::string_view source_;
+  internal::StructuralIndex index_;
+  // Index of the matching closing bracket, at the index of every opening
+  // one.
+  std::vector<uint32_t> closing_;
+  std::unique_ptr<internal::UnescapedStrings> unescaped_{
+      std::make_unique<internal::UnescapedStrings>()};
+};
+
+auto OnDemandIterator::valueIndex() const -> size_t {
+  // A name is followed by its closing quotation mark and the colon.
+  return idx_ + (document_->isName(idx_) ? 3 : 0);
+}
+
+auto OnDemandIterator::token() const -> std::optional<Token> {
+  if (*this == document_->end()) return std::nullopt;
+  const auto value = valueIndex();
+  switch (internal::classify(document_->at(value))) {
+    case internal::CharClass::Number:
+    case internal::CharClass::LiteralTrue:
+    case internal::CharClass::LiteralFalse:
+    case internal::CharClass::LiteralNull:
+      return document_->token(value);
+    default:
+      return std::nullopt;
+  }
+}
+
+auto OnDemandIterator::string() const -> std::optional<std::string_view> {
+  if (*this == document_->end()) return std::nullopt;
+  const auto value = valueIndex();
+  if (document_->at(value) != '"') return std::nullopt;
+  return document_->text(value);
+}
+
+auto OnDemandIterator::number() const -> std::optional<double> {
+  const auto token = this->token();
+  if (!token || token->type != Token::Type::Number) return std::nullopt;
+  return token->number.real();
+}
+
+auto OnDemandIterator::integer() const -> std::optional<int64_t> {
+  const auto token = this->token();
+  if (!token || token->type != Token::Type::Number ||
+      token->number.kind != internal::ScannedNumber::Kind::Integer)
+    return std::nullopt;
+  return token->number.integer();
+}
+
+auto OnDemandIterator::uint64() const -> std::optional<uint64_t> {
+  const auto token = this->token();
+  if (!token || token->type != Token::Type::Number) return std::nullopt;
+  const auto& number = token->number;
+  if (number.kind == internal::ScannedNumber::Kind::UInt64 ||
+      (number.kind == internal::ScannedNumber::Kind::Integer &&
+       number.integer() >= 0))
+    return number.uint64();
+  return std::nullopt;
+}
+
+auto OnDemandIterator::boolean() const -> std::optional<bool> {
+  const auto token = this->token();
+  if (!token || (token->type != Token::Type::True &&
+                 token->type != Token::Type::False))
+    return std::nullopt;
+  return token->type == Token::Type::True;
+}
+
+auto OnDemandIterator::value() const -> Value {
+  if (*this == document_->end()) return Null{};
+  switch (document_->at(valueIndex())) {
+    case '{':
+      return Object{};
+    case '[':
+      return Array{};
+    case '"':
+      if (auto text = string()) return String{*text};
+      return Null{};
+    default:
+      break;
+  }
+  if (auto integer = this->integer()) return Integer{*integer};
+  if (auto integer = uint64()) return UInt64{*integer};
+  if (auto number = this->number()) return Number{*number};
+  if (auto boolean = this->boolean()) return Boolean{*boolean};
+  return Null{};
+}
+
+auto OnDemandIterator::name() const -> std::optional<std::string_view> {
+  if (*this == document_->end()) return std::nullopt;
+  if (!document_->isName(idx_)) return std::string_view{};
+  return document_->text(idx_);
+}
+
+auto OnDemandIterator::operator[](std::string_view key) const
+    -> OnDemandIterator {
+  for (auto child = begin(); !document_->isEnd(child.idx_); ++child) {
+    if (document_->isName(child.idx_) && child.name() == key) return child;
+  }
+  return document_->end();
+}
+
+auto OnDemandIterator::operator[](size_t offset) const -> OnDemandIterator {
+  for (auto child = begin(); !document_->isEnd(child.idx_); ++child) {
+    if (0 == offset--) return child;
+  }
+  return document_->end();
+}
+
+auto OnDemandIterator::has(std::string_view key) const -> bool {
+  return (*this)[key] != document_->end();
+}
+
+auto OnDemandIterator::size() const -> size_t {
+  size_t count = 0;
+  for (auto child = begin(); !document_->isEnd(child.idx_); ++child) ++count;
+  return count;
+}
+
+auto OnDemandIterator::begin() const -> OnDemandIterator {
+  if (*this == document_->end()) return *this;
+  const auto value = valueIndex();
+  const auto chr = document_->at(value);
+  if (chr != '{' && chr != '[') return document_->end();
+  return OnDemandIterator{document_, value + 1};
+}
+
+// Containers end at their closing bracket.
+auto OnDemandIterator::end() const -> OnDemandIterator {
+  if (*this == document_->end()) return *this;
+  const auto value = valueIndex();
+  const auto chr = document_->at(value);
+  if (chr != '{' && chr != '[') return document_->end();
+  return OnDemandIterator{document_, document_->skip(value) - 1};
+}
+
+auto OnDemandIterator::operator++() -> OnDemandIterator& {
+  if (*this != document_->end()) idx_ = document_->next(valueIndex());
+  return *this;
+}
+
+}  // namespace json
+
+#endif  // ON_DEMAND_HH
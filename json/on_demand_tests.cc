@@ -0,0 +1,59 @@
+#include <string>
+#include <variant>
+
+#include "json/on_demand.hh"
+#include "json/value.hh"
+#include "testrunner/testrunner.h"
+
+TEST(OnDemand_NavigatesLikeJson) {
+  const std::string source =
+      R"({"skipped": [{"a": [1, [2]]}, "]"], "name": "x\ty", )"
+      R"("values": [1.5, true, null, {}], "nested": {"deep": [false]}})";
+  auto document = json::OnDemand::parse(source);
+  ASSERT_TRUE(document);
+
+  ASSERT_TRUE(std::holds_alternative<json::Object>(document->value()));
+  EXPECT_EQ(*(*document)["name"].string(), "x\ty");
+  EXPECT_EQ(*(*document)["values"][0].number(), 1.5);
+  EXPECT_TRUE(*(*document)["values"][1].boolean());
+  EXPECT_TRUE(
+      std::holds_alternative<json::Null>((*document)["values"][2].value()));
+  EXPECT_EQ((*document)["values"].size(), 4);
+  EXPECT_EQ((*document)["values"][3].size(), 0);
+  EXPECT_FALSE(*(*document)["nested"]["deep"][0].boolean());
+  EXPECT_TRUE((*document)["values"][4] == document->end());
+  EXPECT_FALSE(document->has("deep"));
+
+  std::string names;
+  for (const auto& member : document->begin()) {
+    names += *member.name();
+    names += " ";
+  }
+  EXPECT_EQ(names, "skipped name values nested ");
+}
+
+TEST(OnDemand_ChecksStructureOnly) {
+  EXPECT_TRUE(json::OnDemand::parse(""));
+  EXPECT_EQ(json::OnDemand::parse("[1, 2").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::OnDemand::parse(R"({"a" 1})").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::OnDemand::parse("[1, 2}").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::OnDemand::parse("[1,]").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::OnDemand::parse("[1] 2").status(),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(json::OnDemand::parse(R"(["a)").status(),
+            json::Status::UnexpectedCharacter);
+  EXPECT_EQ(json::OnDemand::parse("[@]").status(),
+            json::Status::UnexpectedCharacter);
+
+  // Values are only checked when read.
+  auto document = json::OnDemand::parse(R"([1x, trueish, "\q", 2])");
+  ASSERT_TRUE(document);
+  EXPECT_FALSE(document->begin()[0].number());
+  EXPECT_FALSE(document->begin()[1].boolean());
+  EXPECT_FALSE(document->begin()[2].string());
+  EXPECT_EQ(*document->begin()[3].number(), 2);
+}
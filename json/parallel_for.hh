@@ -0,0 +1,40 @@
+#ifndef PARALLEL_FOR_HH
+#define PARALLEL_FOR_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace json::internal {
+
+// Number of threads to use for a requested count, where 0 means one per
+// core.
+[[nodiscard]] inline auto workerThreads(unsigned threads) -> unsigned {
+  if (threads != 0) return threads;
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+// Calls `work(item)` for items 0 to `items` - 1 on `threads` threads,
+// including the calling one. Threads take the next item from a shared
+// counter, so uneven items balance out.
+template <typename Work>
+void parallelFor(size_t items, unsigned threads, const Work& work) {
+  std::atomic<size_t> next{0};
+  const auto worker = [&] {
+    for (auto item = next.fetch_add(1, std::memory_order_relaxed);
+         item < items; item = next.fetch_add(1, std::memory_order_relaxed))
+      work(item);
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned idx = 1; idx < threads && idx < items; ++idx)
+    pool.emplace_back(worker);
+  worker();
+  for (auto& thread : pool) thread.join();
+}
+
+}  // namespace json::internal
+
+#endif  // PARALLEL_FOR_HH
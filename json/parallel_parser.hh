@@ -0,0 +1,236 @@
+#ifndef PARALLEL_PARSER_HH
+#define PARALLEL_PARSER_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "json/character_utils.hh"
+#include "json/parallel_for.hh"
+#include "json/parser.hh"
+#include "json/status.hh"
+#include "json/tape.hh"
+
+//
+// Parses a document whose value is one large array on several threads.
+//
+// A quick pre-scan, which only tracks strings and bracket depth, cuts the
+// array's elements into segments at top level commas. Every segment is
+// parsed by its own Parser as the children of a placeholder array, and the
+// segments' tapes are then copied, again in parallel, into one tape with
+// parent indices and arena offsets moved to their final place.
+//
+// The result is exactly the tape a sequential parse produces. Anything
+// unusual, such as a document that is not an array, malformed brackets or a
+// syntax error in any segment, makes parse() give up, and the caller parses
+// sequentially; errors are therefore always reported by the sequential
+// parser.
+//
+
+namespace json::internal {
+
+// Documents below this size are not worth splitting.
+inline constexpr size_t ParallelParseMinimumSize = 1024 * 1024;
+inline constexpr size_t ParallelParseMinimumSegment = 256 * 1024;
+
+// Some more segments than threads, so that threads finishing early can pick
+// up the remainder.
+[[nodiscard]] inline auto parallelSegmentSize(size_t source_size,
+                                              unsigned threads) -> size_t {
+  return std::max(source_size / (size_t{threads} * 4),
+                  ParallelParseMinimumSegment);
+}
+
+// Bytes the pre-scan has to look at; everything else is skipped.
+inline constexpr auto SplitCharacters = [] {
+  std::array<bool, 256> characters{};
+  for (unsigned char chr : {'"', '[', ']', '{', '}', ','})
+    characters[chr] = true;
+  return characters;
+}();
+
+// Cuts the elements of the array `json_source` consists of into runs of at
+// least `segment_size` bytes, leaving out the brackets and the commas
+// between runs. Returns nothing if the source is not an array with matching
+// outer brackets.
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+[[nodiscard]] inline auto splitArray(std::string_view json_source,
+                                     size_t segment_size)
+    -> std::vector<std::string_view> {
+  size_t pos = 0;
+  while (pos != json_source.size() && isWhitespace(json_source[pos])) ++pos;
+  if (pos == json_source.size() || json_source[pos] != '[') return {};
+
+  std::vector<std::string_view> segments;
+  auto start = pos + 1;
+  auto next_cut = start + segment_size;
+  size_t depth = 0;
+  for (; pos < json_source.size(); ++pos) {
+    while (!SplitCharacters[static_cast<unsigned char>(json_source[pos])]) {
+      if (++pos == json_source.size()) return {};
+    }
+
+    switch (json_source[pos]) {
+      case '"':
+        // Skips to the closing quotation mark, like the tokenizer does.
+        do {
+          pos = json_source.find('"', pos + 1);
+          if (pos == std::string_view::npos) return {};
+        } while (isEscaped(json_source, pos));
+        break;
+      case '[':
+      case '{':
+        ++depth;
+        break;
+      case '}':
+        if (--depth == 0) return {};
+        break;
+      case ']':
+        if (--depth == 0) {
+          segments.push_back(json_source.substr(start, pos - start));
+          while (++pos != json_source.size()) {
+            if (!isWhitespace(json_source[pos])) return {};
+          }
+          return segments;
+        }
+        break;
+      default:
+        if (depth == 1 && pos >= next_cut) {
+          segments.push_back(json_source.substr(start, pos - start));
+          start = pos + 1;
+          next_cut = start + segment_size;
+        }
+        break;
+    }
+  }
+  return {};
+}
+
+template <typename Index = uint32_t>
+class ParallelParser {
+  using Entry = TapeEntry<Index>;
+
+  std::vector<Parser<Index>> parsers_;
+  bool has_escapes_{};
+
+ public:
+  // Parses `json_source` into `tape` on `threads` threads. Returns false,
+  // leaving `tape` empty, if the source cannot be parsed in segments of
+  // `segment_size`; the source then needs a sequential parse.
+  [[nodiscard]] auto parse(std::string_view json_source,
+                           StringStorage string_storage, unsigned threads,
+                           size_t segment_size, Tape<Index>& tape) -> bool {
+    tape.entries.clear();
+    tape.strings.clear();
+    tape.elements.clear();
+    has_escapes_ = false;
+
+    const auto segments = splitArray(json_source, segment_size);
+    if (segments.size() < 2) return false;
+
+    parsers_.resize(segments.size());
+    std::vector<Status> statuses(segments.size());
+    parallelFor(segments.size(), threads, [&](size_t segment) {
+      auto& parser = parsers_[segment];
+      parser.reset({}, string_storage);
+      statuses[segment] = parser.parseElements(json_source, segments[segment]);
+    });
+    if (std::ranges::any_of(statuses,
+                            [](Status status) { return status != Status::Ok; }))
+      return false;
+
+    return join(string_storage, threads, tape);
+  }
+
+  // True if any borrowed string or key contains escape sequences.
+  [[nodiscard]] auto hasEscapes() const -> bool { return has_escapes_; }
+
+ private:
+  // Where a segment's entries, text and element tables go in the result.
+  struct Placement {
+    size_t entry{};
+    size_t text{};
+    size_t element{};
+  };
+
+  [[nodiscard]] auto join(StringStorage string_storage, unsigned threads,
+                          Tape<Index>& tape) -> bool {
+    // Entry 0 of every segment is its placeholder; the result has one root
+    // array in its place.
+    std::vector<Placement> placements(parsers_.size() + 1, Placement{1, 0, 0});
+    size_t elements = 0;
+    for (size_t segment = 0; segment != parsers_.size(); ++segment) {
+      const auto& part = parsers_[segment].tape();
+      auto& next = placements[segment + 1];
+      next.entry = placements[segment].entry + part.entries.size() - 1;
+      next.text = placements[segment].text + part.strings.size();
+      next.element = placements[segment].element + part.elements.size();
+      elements += part.entries.front().count();
+      has_escapes_ = has_escapes_ || parsers_[segment].hasEscapes();
+    }
+
+    // The sequential parser reports documents that are too large.
+    const auto& total = placements.back();
+    if (total.entry > Entry::MaxSize ||
+        total.text > std::numeric_limits<Index>::max() ||
+        elements > std::numeric_limits<Index>::max())
+      return false;
+
+    tape.entries.resize(total.entry);
+    tape.strings.resize(total.text);
+    tape.elements.resize(total.element);
+    parallelFor(parsers_.size(), threads, [&](size_t segment) {
+      place(parsers_[segment].tape(), placements[segment], string_storage,
+            tape);
+    });
+
+    auto& root = tape.entries.front();
+    root = Entry::make(EntryType::Array, Tape<Index>::Root);
+    root.setSize(static_cast<Index>(total.entry - 1));
+    root.setCount(static_cast<Index>(elements));
+
+    // Like TapeBuilder::closeContainer(), which would have closed the root
+    // last.
+    if (root.count() > 1 && root.size() != root.count()) {
+      tape.elements.reserve(total.element + elements);
+      root.setTable(static_cast<Index>(tape.elements.size() + 1));
+      for (Index offset = 1; offset <= root.size();
+           offset += 1 + tape.entries[offset].size())
+        tape.elements.push_back(offset);
+    }
+    return true;
+  }
+
+  static void place(const Tape<Index>& part, const Placement& placement,
+                    StringStorage string_storage, Tape<Index>& tape) {
+    const auto shift = static_cast<Index>(placement.entry - 1);
+    for (size_t idx = 1; idx != part.entries.size(); ++idx) {
+      auto entry = part.entries[idx];
+      if (entry.parent() != 0)
+        entry.setParent(static_cast<Index>(entry.parent() + shift));
+
+      const auto type = entry.type();
+      if ((type == EntryType::String || type == EntryType::Key) &&
+          string_storage == StringStorage::Copy)
+        entry.setTextOffset(
+            static_cast<Index>(entry.textOffset() + placement.text));
+      if (type == EntryType::Array && entry.table() != 0)
+        entry.setTable(static_cast<Index>(entry.table() + placement.element));
+
+      tape.entries[idx + shift] = entry;
+    }
+
+    std::ranges::copy(part.strings, tape.strings.begin() +
+                                        static_cast<ptrdiff_t>(placement.text));
+    std::ranges::copy(part.elements,
+                      tape.elements.begin() +
+                          static_cast<ptrdiff_t>(placement.element));
+  }
+};
+
+}  // namespace json::internal
+
+#endif  // PARALLEL_PARSER_HH
@@ -0,0 +1,67 @@
+#include <string>
+#include <string_view>
+
+#include "json/json.hh"
+#include "json/parallel_parser.hh"
+#include "json/parser.hh"
+#include "testrunner/testrunner.h"
+
+using json::internal::ParallelParser;
+using json::internal::StringStorage;
+
+TEST(ParallelParser_ProducesIdenticalTapes) {
+  for (const std::string_view doc :
+       {R"([1, 2, 3, 4])",
+        R"( [{"a": [1, {"b": "x\"]"}], "c": "A"}, [[], [2]], "s\\",
+            3, {}, [4, 5, [6]], null ] )",
+        R"([[1], 2, [3, [4, [5]]], "]", "[", {"k": ","}])"}) {
+    for (const auto storage : {StringStorage::Copy, StringStorage::Borrow}) {
+      json::internal::Parser<> sequential(storage);
+      ASSERT_EQ(sequential.parse(doc), json::Status::Ok);
+
+      size_t parsed = 0;
+      for (size_t segment_size = 0; segment_size <= doc.size();
+           ++segment_size) {
+        ParallelParser<> parallel;
+        json::internal::Tape<uint32_t> tape;
+        if (!parallel.parse(doc, storage, 3, segment_size, tape)) continue;
+        EXPECT_TRUE(tape == sequential.tape());
+        EXPECT_EQ(parallel.hasEscapes(), sequential.hasEscapes());
+        ++parsed;
+      }
+      EXPECT_TRUE(parsed != 0);
+    }
+  }
+}
+
+TEST(ParallelParser_LeavesUnusualInputToTheSequentialParser) {
+  for (const std::string_view doc :
+       {"", "1", R"({"a": [1, 2]})", "[]", "[1]", "[1, 2", "[1, 2}",
+        "[1, 2] 3", "[1,, 2]", "[1, 2,]", "[[1, 2], [3}]", R"(["a, "b"])",
+        "[1 2, 3]"}) {
+    ParallelParser<> parallel;
+    json::internal::Tape<uint32_t> tape;
+    EXPECT_FALSE(parallel.parse(doc, StringStorage::Copy, 4, 0, tape));
+    EXPECT_TRUE(tape.entries.empty());
+  }
+}
+
+TEST(ParallelParser_SelectableThroughParseOptions) {
+  std::string source = "[";
+  while (source.size() < 3 * json::internal::ParallelParseMinimumSize)
+    source += R"({"id": 1, "tags": ["a", "b"]}, )";
+  source += R"("last"])";
+
+  auto sequential = json::Json::parse(source);
+  auto parallel = json::Json::parse(source, {.threads = 4});
+  ASSERT_TRUE(sequential);
+  ASSERT_TRUE(parallel);
+  const auto size = sequential->begin().size();
+  EXPECT_EQ(parallel->begin().size(), size);
+  EXPECT_EQ(*parallel->begin()[size - 1].string(), "last");
+  EXPECT_EQ(*parallel->begin()[size / 2]["tags"][1].string(), "b");
+
+  source.back() = '}';
+  EXPECT_EQ(json::Json::parse(source, {.threads = 4}).status(),
+            json::Status::UnexpectedToken);
+}
@@ -0,0 +1,52 @@
+#ifndef PARSE_OPTIONS_HH
+#define PARSE_OPTIONS_HH
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "json/parse_stats.hh"
+
+namespace json {
+
+struct ParseOptions {
+  // Run a SIMD pass that indexes all structural characters and strings before
+  // parsing (see json/structural_index.hh). Pays off for large documents;
+  // inputs of 4 GiB and above are always parsed without an index.
+  bool structural_index = false;
+
+  // Strings and names refer directly into the source instead of into a copy
+  // owned by the document. The caller must keep the source alive and
+  // unchanged for as long as the document is used.
+  bool borrow_source = false;
+
+  // Objects with at least this many members get a hash index over their
+  // names, which makes operator[] and has() on them constant time instead of
+  // linear. Costs a pass over the document and a few bytes per member after
+  // parsing. 0 disables the index.
+  size_t key_index_threshold = 0;
+
+  // Threads that parse a document whose value is a large array, 0 for one
+  // per core. The array's elements are split between the threads (see
+  // json/parallel_parser.hh). Small documents, other values and anything
+  // the split cannot handle are parsed on the calling thread; the result is
+  // the same either way.
+  unsigned threads = 1;
+
+  // Receives the statistics of the parse, which are only collected in builds
+  // with JSON_PARSE_STATS (see json/parse_stats.hh). Left alone otherwise.
+  ParseStats* stats = nullptr;
+
+  // Where documents and the parsers that build them allocate their memory,
+  // for example a std::pmr::monotonic_buffer_resource per request. It must
+  // outlive the documents. Threads parsing parts of a document (see
+  // `threads`) use the default resource until the parts are joined, and so
+  // do the parser state parseInto() keeps, which stops allocating once it
+  // has grown, and the per thread documents of forEachLine() (see
+  // json/json_lines.hh).
+  std::pmr::memory_resource* memory_resource =
+      std::pmr::get_default_resource();
+};
+
+}  // namespace json
+
+#endif  // PARSE_OPTIONS_HH
@@ -0,0 +1,210 @@
+#ifndef PARSE_STATS_HH
+#define PARSE_STATS_HH
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "json/token.hh"
+
+//
+// Statistics about where the time and memory of parsing go.
+//
+// They are only collected in builds with JSON_PARSE_STATS defined, which
+// must be the same for every translation unit of a program. Without it, the
+// hooks the parser calls below are empty and compile to nothing. With it,
+// every token is timed, which makes parsing several times slower.
+//
+// Each parse of a json::Json reports its statistics through
+// ParseOptions::stats, and adds them to totals for the calling thread:
+//
+//   json::ParseStats stats;
+//   auto json = json::Json::parse(source, {.stats = &stats});
+//   auto strings = stats.tokenCount(json::Token::Type::String);
+//
+// Of parses that are split across threads (ParseOptions::threads), only
+// the share of the calling thread is counted, except for nodes and string
+// bytes.
+//
+
+namespace json {
+
+struct ParseStats {
+  static constexpr size_t TokenTypes =
+      static_cast<size_t>(Token::Type::Null) + 1;
+
+  // Parses counted, 1 for a single parse.
+  uint64_t documents{};
+  // Tokens read, by Token::Type.
+  std::array<uint64_t, TokenTypes> tokens{};
+  // Tape entries: values, and the names of members.
+  uint64_t nodes{};
+  // Of nested objects and arrays; 1 for a document that is one array.
+  uint64_t max_depth{};
+  // Text copied into the string arena, after unescaping.
+  uint64_t string_bytes{};
+  // Times the parser's state stacks or one of the tape's buffers had to
+  // grow, which is most of what a parse allocates. Not counted: the copy of
+  // the source, unescaped borrowed strings, key index tables, the
+  // structural index and the tapes of parallel parses.
+  uint64_t buffer_growths{};
+  // Spent splitting the source into tokens.
+  std::chrono::nanoseconds tokenizer_time{};
+  // Spent checking the grammar and building the tape from the tokens.
+  std::chrono::nanoseconds parser_time{};
+
+  [[nodiscard]] auto tokenCount(Token::Type type) const -> uint64_t {
+    return tokens[static_cast<size_t>(type)];
+  }
+
+  void add(const ParseStats& other) {
+    documents += other.documents;
+    for (size_t type = 0; type != TokenTypes; ++type)
+      tokens[type] += other.tokens[type];
+    nodes += other.nodes;
+    max_depth = std::max(max_depth, other.max_depth);
+    string_bytes += other.string_bytes;
+    buffer_growths += other.buffer_growths;
+    tokenizer_time += other.tokenizer_time;
+    parser_time += other.parser_time;
+  }
+};
+
+#ifdef JSON_PARSE_STATS
+inline constexpr bool ParseStatsEnabled = true;
+#else
+inline constexpr bool ParseStatsEnabled = false;
+#endif
+
+namespace internal {
+
+// The statistics of all parses on this thread so far.
+[[nodiscard]] inline auto threadParseStatsTotals() -> ParseStats& {
+  thread_local ParseStats totals;
+  return totals;
+}
+
+// The statistics of the parse in progress on this thread.
+[[nodiscard]] inline auto currentParseStats() -> ParseStats& {
+  thread_local ParseStats current;
+  return current;
+}
+
+}  // namespace internal
+
+// The statistics of all parses on the calling thread since it started, or
+// since the last resetThreadParseStats().
+[[nodiscard]] inline auto threadParseStats() -> const ParseStats& {
+  return internal::threadParseStatsTotals();
+}
+
+inline void resetThreadParseStats() { internal::threadParseStatsTotals() = {}; }
+
+namespace internal {
+
+#ifdef JSON_PARSE_STATS
+
+inline void countToken(Token::Type type) {
+  ++currentParseStats().tokens[static_cast<size_t>(type)];
+}
+
+inline void countDepth(size_t depth) {
+  auto& stats = currentParseStats();
+  stats.max_depth = std::max<uint64_t>(stats.max_depth, depth);
+}
+
+// Adds the time until it goes out of scope to one of the timings.
+class StatsTimer {
+  std::chrono::nanoseconds ParseStats::*timing_;
+  std::chrono::steady_clock::time_point start_ =
+      std::chrono::steady_clock::now();
+
+ public:
+  explicit StatsTimer(std::chrono::nanoseconds ParseStats::*timing)
+      : timing_{timing} {}
+
+  StatsTimer(const StatsTimer&) = delete;
+  auto operator=(const StatsTimer&) -> StatsTimer& = delete;
+
+  ~StatsTimer() {
+    currentParseStats().*timing_ += std::chrono::steady_clock::now() - start_;
+  }
+};
+
+// Counts a growth if `buffer` grew before it goes out of scope.
+template <typename Buffer>
+class GrowthCounter {
+  const Buffer& buffer_;
+  size_t capacity_;
+
+ public:
+  explicit GrowthCounter(const Buffer& buffer)
+      : buffer_{buffer}, capacity_{buffer.capacity()} {}
+
+  GrowthCounter(const GrowthCounter&) = delete;
+  auto operator=(const GrowthCounter&) -> GrowthCounter& = delete;
+
+  ~GrowthCounter() {
+    if (buffer_.capacity() != capacity_) ++currentParseStats().buffer_growths;
+  }
+};
+
+// Collects the statistics of one parse, from construction to destruction,
+// and reports them to `out` and the thread's totals.
+class ParseStatsScope {
+  ParseStats* out_;
+
+ public:
+  explicit ParseStatsScope(ParseStats* out) : out_{out} {
+    currentParseStats() = {};
+    currentParseStats().documents = 1;
+  }
+
+  ParseStatsScope(const ParseStatsScope&) = delete;
+  auto operator=(const ParseStatsScope&) -> ParseStatsScope& = delete;
+
+  ~ParseStatsScope() {
+    threadParseStatsTotals().add(currentParseStats());
+    if (out_ != nullptr) *out_ = currentParseStats();
+  }
+
+  // What the parse produced.
+  void result(size_t nodes, size_t string_bytes) {
+    currentParseStats().nodes = nodes;
+    currentParseStats().string_bytes = string_bytes;
+  }
+};
+
+#else
+
+inline void countToken(Token::Type /*type*/) {}
+
+inline void countDepth(size_t /*depth*/) {}
+
+class StatsTimer {
+ public:
+  explicit StatsTimer(std::chrono::nanoseconds ParseStats::* /*timing*/) {}
+};
+
+template <typename Buffer>
+class GrowthCounter {
+ public:
+  explicit GrowthCounter(const Buffer& /*buffer*/) {}
+};
+
+class ParseStatsScope {
+ public:
+  explicit ParseStatsScope(ParseStats* /*out*/) {}
+
+  void result(size_t /*nodes*/, size_t /*string_bytes*/) {}
+};
+
+#endif
+
+}  // namespace internal
+
+}  // namespace json
+
+#endif  // PARSE_STATS_HH
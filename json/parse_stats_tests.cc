@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <string_view>
+
+#include "json/json.hh"
+#include "json/parse_stats.hh"
+#include "testrunner/testrunner.h"
+
+// Built into its own test binary, with statistics enabled for all of it.
+static_assert(json::ParseStatsEnabled,
+              "parse_stats_tests.cc needs -DJSON_PARSE_STATS");
+
+namespace {
+
+constexpr std::string_view Source =
+    R"({"a": [1, 2, {"b": "x\ny"}], "c": null})";
+
+}  // namespace
+
+TEST(ParseStats_CountsOneParse) {
+  json::ParseStats stats;
+  ASSERT_TRUE(json::Json::parse(Source, {.stats = &stats}));
+
+  using Type = json::Token::Type;
+  EXPECT_EQ(stats.documents, uint64_t{1});
+  EXPECT_EQ(stats.tokenCount(Type::LeftCurlyBracket), uint64_t{2});
+  EXPECT_EQ(stats.tokenCount(Type::RightCurlyBracket), uint64_t{2});
+  EXPECT_EQ(stats.tokenCount(Type::LeftSquareBracket), uint64_t{1});
+  EXPECT_EQ(stats.tokenCount(Type::RightSquareBracket), uint64_t{1});
+  EXPECT_EQ(stats.tokenCount(Type::String), uint64_t{4});
+  EXPECT_EQ(stats.tokenCount(Type::Number), uint64_t{2});
+  EXPECT_EQ(stats.tokenCount(Type::Null), uint64_t{1});
+  EXPECT_EQ(stats.tokenCount(Type::Colon), uint64_t{3});
+  EXPECT_EQ(stats.tokenCount(Type::Comma), uint64_t{3});
+  EXPECT_EQ(stats.tokenCount(Type::True), uint64_t{0});
+  EXPECT_EQ(stats.nodes, uint64_t{10});
+  EXPECT_EQ(stats.max_depth, uint64_t{3});
+  // "a", "b", "x\ny" unescaped, and "c".
+  EXPECT_EQ(stats.string_bytes, uint64_t{6});
+  EXPECT_TRUE(stats.buffer_growths > 0);
+  EXPECT_TRUE(stats.tokenizer_time.count() > 0);
+  EXPECT_TRUE(stats.parser_time.count() > 0);
+
+  // Nothing is copied from a borrowed source, and the index walks the same
+  // tokens.
+  json::ParseStats borrowed;
+  ASSERT_TRUE(json::Json::parse(
+      Source, {.structural_index = true, .borrow_source = true,
+               .stats = &borrowed}));
+  EXPECT_EQ(borrowed.string_bytes, uint64_t{0});
+  EXPECT_EQ(borrowed.nodes, stats.nodes);
+  EXPECT_TRUE(borrowed.tokens == stats.tokens);
+}
+
+TEST(ParseStats_ParseIntoStopsGrowingBuffers) {
+  json::Json document;
+  json::ParseStats first;
+  ASSERT_EQ(json::Json::parseInto(document, Source, {.stats = &first}),
+            json::Status::Ok);
+
+  json::ParseStats again;
+  ASSERT_EQ(json::Json::parseInto(document, Source, {.stats = &again}),
+            json::Status::Ok);
+  EXPECT_EQ(again.buffer_growths, uint64_t{0});
+  EXPECT_EQ(again.nodes, first.nodes);
+}
+
+TEST(ParseStats_AddsUpPerThread) {
+  json::resetThreadParseStats();
+  ASSERT_TRUE(json::Json::parse("[[1], [[2]]]"));
+  ASSERT_TRUE(json::Json::parse(Source));
+  // Failed parses count up to the error.
+  json::ParseStats failed;
+  ASSERT_FALSE(json::Json::parse("[1, }", {.stats = &failed}));
+  EXPECT_EQ(failed.tokenCount(json::Token::Type::RightCurlyBracket),
+            uint64_t{1});
+
+  const auto& totals = json::threadParseStats();
+  EXPECT_EQ(totals.documents, uint64_t{3});
+  EXPECT_EQ(totals.tokenCount(json::Token::Type::Number), uint64_t{5});
+  EXPECT_EQ(totals.max_depth, uint64_t{3});
+  EXPECT_TRUE(totals.parser_time >= failed.parser_time);
+
+  json::resetThreadParseStats();
+  EXPECT_EQ(json::threadParseStats().documents, uint64_t{0});
+}
@@ -1,210 +1,95 @@
 #ifndef PARSER_HH
 #define PARSER_HH
 
-#include <charconv>
-#include <stack>
+#include <cstdint>
+#include <memory_resource>
 #include <string_view>
-#include <vector>
+#include <utility>
 
-#include "json/node.hh"
+#include "json/event_parser.hh"
 #include "json/status.hh"
-#include "json/token.hh"
-#include "json/tokenizer.hh"
+#include "json/structural_index.hh"
+#include "json/tape.hh"
+#include "json/tape_builder.hh"
 
 namespace json::internal {
 
+// Parses documents into tapes: the EventParser driving a TapeBuilder.
+template <typename Index = uint32_t>
 class Parser {
-  enum class State {
-    ExpectValue,
-    ExpectOptionalValue,
-    ExpectEndOfObject,
-    ExpectValueName,
-    ExpectOptionalValueName,
-    ExpectOptionalCommaInObject,
-    ExpectColon,
-    ExpectEndOfArray
-  };
-
-  std::vector<Node> nodes_;
-  std::stack<size_t> parents_{{Root}};
-  std::stack<State> states_{{State::ExpectValue}};
-  std::string pending_value_name;
+  EventParser<TapeBuilder<Index>> events_;
 
- public:
-  [[nodiscard]] auto parse(std::string_view json_source) -> Status {
-    while (!json_source.empty()) {
-      auto maybe_token = json::internal::Tokenizer::parse(json_source);
-      if (maybe_token) {
-        auto status = parseToken(*maybe_token);
-        if (status != Status::Ok) return status;
-
-      } else if (maybe_token.status() != Status::Ok) {
-        return maybe_token.status();
-      }
-    }
-    return Status::Ok;
+  [[nodiscard]] auto builder() -> TapeBuilder<Index>& {
+    return events_.handler();
   }
 
-  [[nodiscard]] auto nodes() const -> std::vector<Node> { return nodes_; }
-
- private:
-  [[nodiscard]] auto parseToken(const Token& token) -> Status {
-    auto state = states_.top();
-    states_.pop();
-
-    bool optional = true;
-    switch (state) {
-      case State::ExpectOptionalValueName:
-        if (token.type == Token::Type::String) return rememberValueName(token);
-        break;
-
-      case State::ExpectOptionalValue:
-        if (token.startsAValue()) return startNewValue(token);
-        break;
-
-      case State::ExpectOptionalCommaInObject:
-        if (token.type == Token::Type::Comma) return continueObject();
-        break;
-
-      default:
-        optional = false;
-        break;
-    }
-
-    if (optional) {
-      state = states_.top();
-      states_.pop();
-    }
-
-    switch (state) {
-      case State::ExpectValue:
-        return startNewValue(token);
-
-      case State::ExpectValueName:
-        return rememberValueName(token);
-
-      case State::ExpectEndOfObject:
-        return finalizeObject(token);
-
-      case State::ExpectEndOfArray:
-        if (token.type == Token::Type::Comma) return continueArray();
-        return finalizeArray(token);
-
-      case State::ExpectColon:
-        if (token.type != Token::Type::Colon) return Status::UnexpectedToken;
-        return Status::Ok;
-
-      default:
-        break;
-    }
-
-    return Status::Unimplemented;
+ public:
+  // The parser's stacks allocate from `resource`, and so does its tape until
+  // the first reset().
+  explicit Parser(
+      StringStorage string_storage = StringStorage::Copy,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : events_{TapeBuilder<Index>{string_storage, resource}, resource} {}
+
+  // Prepares the parser for the next document, parsing into `storage`.
+  // Neither the parser's stacks nor the storage release their capacity, so
+  // parsing similar documents over and over stops allocating.
+  void reset(Tape<Index>&& storage, StringStorage string_storage) {
+    events_.reset();
+    builder().reset(std::move(storage), string_storage);
   }
 
-  [[nodiscard]] auto startNewValue(const Token& token) -> Status {
-    if (!token.startsAValue()) return Status::UnexpectedToken;
-
-    switch (token.type) {
-      case Token::Type::LeftCurlyBracket:
-        startObject();
-        break;
-
-      case Token::Type::LeftSquareBracket:
-        startArray();
-        break;
-
-      case Token::Type::String:
-        nodes_.emplace_back(
-            Node{String{std::string{token.value}}, parents_.top()});
-        break;
-
-      case Token::Type::Number: {
-        double value{};
-        std::from_chars(token.value.begin(), token.value.end(), value);
-        nodes_.emplace_back(Node{Number{value}, parents_.top()});
-        break;
-      }
-
-      case Token::Type::True:
-      case Token::Type::False: {
-        const auto value = token.type == Token::Type::True;
-        nodes_.emplace_back(Node{Boolean{value}, parents_.top()});
-        break;
-      }
-
-      case Token::Type::Null:
-        nodes_.emplace_back(Node{Null{}, parents_.top()});
-        break;
-
-      default:
-        return Status::Unimplemented;
-    }
-
-    auto* node = &nodes_.back();
-    if (!pending_value_name.empty())
-      node->name = std::exchange(pending_value_name, "");
-
-    while (node->parent != Root) {
-      ++nodes_[node->parent].children;
-      node = &nodes_[node->parent];
-    }
-
-    return Status::Ok;
+  [[nodiscard]] auto parse(std::string_view json_source) -> Status {
+    if (!builder().start(json_source)) return Status::DocumentTooLarge;
+    return builder().complete(events_.parse(json_source));
   }
 
-  void startObject() {
-    auto parent = parents_.top();
-    parents_.push(nodes_.size());
-    nodes_.emplace_back(Node{Object{}, parent});
-    states_.push(State::ExpectEndOfObject);
-    states_.push(State::ExpectOptionalValueName);
+  // Walks a prebuilt structural index instead of tokenizing byte by byte.
+  // Produces exactly the same tokens, and therefore nodes and errors, as
+  // parse() without an index.
+  [[nodiscard]] auto parse(std::string_view json_source,
+                           const StructuralIndex& index) -> Status {
+    if (!builder().start(json_source)) return Status::DocumentTooLarge;
+    return builder().complete(events_.parse(json_source, index));
   }
 
-  [[nodiscard]] auto rememberValueName(const Token& token) -> Status {
-    if (token.type != Token::Type::String) return Status::UnexpectedToken;
-    if (!pending_value_name.empty()) return Status::UnexpectedToken;
-    pending_value_name = std::string{token.value};
-    states_.push(State::ExpectOptionalCommaInObject);
-    states_.push(State::ExpectValue);
-    states_.push(State::ExpectColon);
-    return Status::Ok;
+  // Parses `elements`, a part of `json_source` holding one or more array
+  // elements separated by commas, as the children of a placeholder array at
+  // tape index 0. Fails unless `elements` ends right after a complete
+  // element. The placeholder is neither sized nor closed; see
+  // json/parallel_parser.hh.
+  [[nodiscard]] auto parseElements(std::string_view json_source,
+                                   std::string_view elements) -> Status {
+    if (!builder().start(json_source)) return Status::DocumentTooLarge;
+    return events_.parseElements(elements);
   }
 
-  [[nodiscard]] auto continueObject() -> Status {
-    states_.push(State::ExpectValueName);
-    return Status::Ok;
+  // Parses the next piece of a document that arrives in chunks. Tokens may
+  // be split anywhere; only a token that runs up to the end of `chunk` is
+  // kept until the next call. Text is always copied, so chunks need not
+  // outlive the call. Once an error was returned, the parser needs a
+  // reset().
+  [[nodiscard]] auto feed(std::string_view chunk) -> Status {
+    return events_.feed(chunk);
   }
 
-  [[nodiscard]] auto finalizeObject(const Token& token) -> Status {
-    if (token.type != Token::Type::RightCurlyBracket)
-      return Status::UnexpectedToken;
-    parents_.pop();
-    return Status::Ok;
+  // Ends a document passed in through feed().
+  [[nodiscard]] auto finish() -> Status {
+    return builder().complete(events_.finish());
   }
 
-  void startArray() {
-    auto parent = parents_.top();
-    parents_.push(nodes_.size());
-    nodes_.emplace_back(Node{Array{}, parent});
-    states_.push(State::ExpectEndOfArray);
-    states_.push(State::ExpectOptionalValue);
+  [[nodiscard]] auto tape() const -> const Tape<Index>& {
+    return events_.handler().tape();
   }
 
-  [[nodiscard]] auto continueArray() -> Status {
-    // TODO(ae): Need to check that we didn't start with a comma (i.e. [,true])
-    states_.push(State::ExpectEndOfArray);
-    states_.push(State::ExpectValue);
-    return Status::Ok;
-  }
+  [[nodiscard]] auto takeTape() -> Tape<Index> { return builder().takeTape(); }
 
-  [[nodiscard]] auto finalizeArray(const Token& token) -> Status {
-    if (token.type != Token::Type::RightSquareBracket)
-      return Status::UnexpectedToken;
-    parents_.pop();
-    return Status::Ok;
+  // True if any borrowed string or key contains escape sequences.
+  [[nodiscard]] auto hasEscapes() const -> bool {
+    return events_.handler().hasEscapes();
   }
 };
 
 }  // namespace json::internal
 
-#endif  // PARSER_HH
\ No newline at end of file
+#endif  // PARSER_HH
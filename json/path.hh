@@ -0,0 +1,433 @@
+#ifndef PATH_HH
+#define PATH_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/key_index.hh"
+#include "json/status.hh"
+#include "json/tape.hh"
+
+//
+// Document references in this file refer to:
+//
+//    RFC 6901
+//    JavaScript Object Notation (JSON) Pointer
+//    April 2013
+//
+// Paths are compiled once into their reference tokens, with names unescaped
+// and hashed and array indices converted, and can then be evaluated against
+// any number of documents. Evaluation only visits the values on the way:
+// members are found through the key index where there is one, array
+// elements through the element table, and everything else is skipped whole.
+//
+
+namespace json {
+
+namespace internal {
+
+// One reference token of a compiled path.
+struct PathStep {
+  static constexpr size_t NoIndex = std::numeric_limits<size_t>::max();
+
+  // The unescaped token, matched against member names.
+  std::string key;
+  // hashKey() of `key`.
+  uint64_t hash{};
+  // The array index the token stands for, or NoIndex.
+  size_t index = NoIndex;
+  // "*": every member or element.
+  bool wildcard{};
+
+  [[nodiscard]] auto operator==(const PathStep& other) const -> bool {
+    return wildcard == other.wildcard && key == other.key;
+  }
+};
+
+//" array-index = %x30 / ( %x31-39 *(%x30-39) )
+//"               ; "0", or digits without a leading "0"
+[[nodiscard]] inline auto arrayIndex(std::string_view token) -> size_t {
+  if (token.empty() || (token.size() > 1 && token[0] == '0'))
+    return PathStep::NoIndex;
+  size_t index = 0;
+  for (const char chr : token) {
+    if (chr < '0' || chr > '9') return PathStep::NoIndex;
+    const auto digit = static_cast<size_t>(chr - '0');
+    // Beyond any array anyway.
+    if (index > (PathStep::NoIndex - 1 - digit) / 10)
+      return PathStep::NoIndex;
+    index = index * 10 + digit;
+  }
+  return index;
+}
+
+//" json-pointer    = *( "/" reference-token )
+//" reference-token = *( unescaped / escaped )
+//" escaped         = "~" ( "0" / "1" )
+//"   ; representing '~' and '/', respectively
+[[nodiscard]] inline auto parsePointer(std::string_view pointer,
+                                       std::vector<PathStep>& steps)
+    -> Status {
+  steps.clear();
+  if (pointer.empty()) return Status::Ok;
+  if (pointer[0] != '/') return Status::UnexpectedCharacter;
+
+  size_t pos = 1;
+  while (true) {
+    const auto end = std::min(pointer.find('/', pos), pointer.size());
+    const auto token = pointer.substr(pos, end - pos);
+
+    PathStep step;
+    for (size_t chr = 0; chr != token.size(); ++chr) {
+      if (token[chr] != '~') {
+        step.key.push_back(token[chr]);
+        continue;
+      }
+      if (++chr == token.size() || (token[chr] != '0' && token[chr] != '1'))
+        return Status::UnexpectedCharacter;
+      step.key.push_back(token[chr] == '0' ? '~' : '/');
+    }
+    step.hash = hashKey(step.key);
+    step.index = arrayIndex(token);
+    step.wildcard = token == "*";
+    steps.push_back(std::move(step));
+
+    if (end == pointer.size()) return Status::Ok;
+    pos = end + 1;
+  }
+}
+
+// Evaluates steps on the tape of a document. Positions are tape indices of
+// values, or of the Key entries of members, like those of ValueIterator.
+template <typename Index>
+class PathWalker {
+  using Json = BasicJson<Index>;
+
+ public:
+  [[nodiscard]] static auto empty(const Json& json) -> bool {
+    return json.entries().empty();
+  }
+
+  [[nodiscard]] static auto iterator(const Json& json, size_t position) {
+    return json.iteratorAt(position);
+  }
+
+  // Calls `visit(position)` for every child of the value at `position` that
+  // `step` selects, in document order, while it returns true. Of several
+  // members with the same name, only the first one is selected. Returns
+  // false if `visit` did.
+  template <typename Visit>
+  [[nodiscard]] static auto step(const Json& json, size_t position,
+                                 const PathStep& step, const Visit& visit)
+      -> bool {
+    const auto entries = json.entries();
+    const auto value = valueAt(json, position);
+    const auto& entry = entries[value];
+    const auto end = value + 1 + entry.size();
+
+    if (entry.type() == EntryType::Object) {
+      if (!step.wildcard && entry.table() != 0) {
+        const auto key = json.findMember(entry, step.key, step.hash);
+        return key == 0 || visit(key);
+      }
+      for (auto key = value + 1; key < end;
+           key += 2 + entries[key + 1].size()) {
+        if (step.wildcard) {
+          if (!visit(key)) return false;
+          continue;
+        }
+        // As in ValueIterator, names are compared by length first.
+        const auto& name = entries[key];
+        if ((name.textLength() == step.key.size() || name.escaped()) &&
+            json.text(name) == step.key)
+          return visit(key);
+      }
+    } else if (entry.type() == EntryType::Array) {
+      if (!step.wildcard) {
+        return step.index >= entry.count() ||
+               visit(json.element(value, step.index));
+      }
+      for (auto element = value + 1; element < end;
+           element += 1 + entries[element].size()) {
+        if (!visit(element)) return false;
+      }
+    }
+    return true;
+  }
+
+  // The type of the value at `position`.
+  [[nodiscard]] static auto type(const Json& json, size_t position)
+      -> EntryType {
+    return json.entries()[valueAt(json, position)].type();
+  }
+
+  // Whether the value at `position` is an object with a key index, whose
+  // members step() finds without looking at the others.
+  [[nodiscard]] static auto indexed(const Json& json, size_t position)
+      -> bool {
+    const auto& entry = json.entries()[valueAt(json, position)];
+    return entry.type() == EntryType::Object && entry.table() != 0;
+  }
+
+  // Calls `visit(child, offset)` for every member or element of the value
+  // at `position`, in document order, while it returns true. Children are
+  // positions as in step(); `offset` counts them from 0. Returns false if
+  // `visit` did.
+  template <typename Visit>
+  [[nodiscard]] static auto children(const Json& json, size_t position,
+                                     const Visit& visit) -> bool {
+    const auto entries = json.entries();
+    const auto value = valueAt(json, position);
+    const auto& entry = entries[value];
+    const auto end = value + 1 + entry.size();
+    const auto object = entry.type() == EntryType::Object;
+    if (!object && entry.type() != EntryType::Array) return true;
+
+    size_t offset = 0;
+    for (auto child = value + 1; child < end; ++offset) {
+      if (!visit(child, offset)) return false;
+      child += object ? 2 + entries[child + 1].size()
+                      : 1 + entries[child].size();
+    }
+    return true;
+  }
+
+  // The name of the member at `position`.
+  [[nodiscard]] static auto name(const Json& json, size_t position)
+      -> std::string_view {
+    return json.text(json.entries()[position]);
+  }
+
+ private:
+  [[nodiscard]] static auto valueAt(const Json& json, size_t position)
+      -> size_t {
+    return position +
+           (json.entries()[position].type() == EntryType::Key ? 1 : 0);
+  }
+};
+
+}  // namespace internal
+
+// A compiled JSON Pointer:
+//
+//   const auto path = json::Path::compile("/users/3/name");
+//   auto name = path->find(*json).string();
+//
+// Besides RFC 6901, a token "*" selects every member of an object or element
+// of an array; members named "*" cannot be addressed.
+class Path {
+  std::vector<internal::PathStep> steps_;
+
+ public:
+  // "" refers to the whole document. Anything else starts with "/"; "~0" and
+  // "~1" in names stand for "~" and "/".
+  [[nodiscard]] static auto compile(std::string_view pointer)
+      -> StatusOr<Path> {
+    Path path;
+    auto status = internal::parsePointer(pointer, path.steps_);
+    if (status != Status::Ok) return status;
+    return path;
+  }
+
+  // The first value the path refers to, in document order, or end().
+  template <typename Index>
+  [[nodiscard]] auto find(const BasicJson<Index>& json) const
+      -> ValueIterator<BasicJson<Index>> {
+    auto result = json.end();
+    forEach(json, [&](const auto& value) {
+      result = value;
+      return false;
+    });
+    return result;
+  }
+
+  // Calls `visit(value)` for every value the path refers to, in document
+  // order, until it returns false if it returns anything. More than one only
+  // with wildcards.
+  template <typename Index, typename Visitor>
+  void forEach(const BasicJson<Index>& json, const Visitor& visit) const {
+    if (internal::PathWalker<Index>::empty(json)) return;
+    static_cast<void>(walk(json, 0, 0, [&](const auto& value) {
+      if constexpr (requires { bool{visit(value)}; }) {
+        return bool{visit(value)};
+      } else {
+        visit(value);
+        return true;
+      }
+    }));
+  }
+
+ private:
+  friend class PathSet;
+
+  template <typename Index, typename Visit>
+  [[nodiscard]] auto walk(const BasicJson<Index>& json, size_t position,
+                          size_t depth, const Visit& visit) const -> bool {
+    using Walker = internal::PathWalker<Index>;
+    if (depth == steps_.size())
+      return visit(Walker::iterator(json, position));
+    return Walker::step(json, position, steps_[depth], [&](size_t child) {
+      return walk(json, child, depth + 1, visit);
+    });
+  }
+};
+
+// Several paths, evaluated together in one walk over the document. Paths
+// that start with the same tokens share the work for them. Where paths go
+// on to several members of an object without a key index, or to several
+// elements of an array one of them selects with "*", the members are read
+// once for all of them.
+class PathSet {
+  struct Node {
+    // The paths that end here.
+    std::vector<size_t> paths;
+    std::vector<std::pair<internal::PathStep, size_t>> children;
+    // Whether one of the children is "*".
+    bool wildcard{};
+  };
+
+  std::vector<Node> nodes_{1};
+  size_t size_{};
+
+ public:
+  // Returns the number by which results refer to `path`.
+  auto add(const Path& path) -> size_t {
+    size_t node = 0;
+    for (const auto& step : path.steps_) {
+      auto& children = nodes_[node].children;
+      auto child = std::find_if(
+          children.begin(), children.end(),
+          [&](const auto& candidate) { return candidate.first == step; });
+      if (child != children.end()) {
+        node = child->second;
+        continue;
+      }
+      nodes_[node].wildcard = nodes_[node].wildcard || step.wildcard;
+      children.emplace_back(step, nodes_.size());
+      node = nodes_.size();
+      nodes_.emplace_back();
+    }
+    nodes_[node].paths.push_back(size_);
+    return size_++;
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+
+  // Sets results[i] to the first value path i refers to, or to end(). Reuses
+  // the capacity of `results`.
+  template <typename Index>
+  void find(const BasicJson<Index>& json,
+            std::vector<ValueIterator<BasicJson<Index>>>& results) const {
+    results.assign(size_, json.end());
+    size_t found = 0;
+    if (size_ == 0 || internal::PathWalker<Index>::empty(json)) return;
+    std::vector<uint8_t> matched;
+    static_cast<void>(
+        walk(json, 0, 0, matched, [&](size_t path, const auto& value) {
+          if (results[path] == json.end()) {
+            results[path] = value;
+            ++found;
+          }
+          return found != size_;
+        }));
+  }
+
+  // Calls `visit(path, value)` for every value any path refers to. The
+  // values of each path come in document order.
+  template <typename Index, typename Visitor>
+  void forEach(const BasicJson<Index>& json, const Visitor& visit) const {
+    if (internal::PathWalker<Index>::empty(json)) return;
+    std::vector<uint8_t> matched;
+    static_cast<void>(
+        walk(json, 0, 0, matched, [&](size_t path, const auto& value) {
+          visit(path, value);
+          return true;
+        }));
+  }
+
+ private:
+  // `matched` is scratch space for walkChildren(), used as a stack.
+  template <typename Index, typename Visit>
+  [[nodiscard]] auto walk(const BasicJson<Index>& json, size_t node,
+                          size_t position, std::vector<uint8_t>& matched,
+                          const Visit& visit) const -> bool {
+    using Walker = internal::PathWalker<Index>;
+    for (const auto path : nodes_[node].paths) {
+      if (!visit(path, Walker::iterator(json, position))) return false;
+    }
+
+    const auto& children = nodes_[node].children;
+    if (children.size() > 1 && !Walker::indexed(json, position) &&
+        (Walker::type(json, position) == internal::EntryType::Object ||
+         nodes_[node].wildcard))
+      return walkChildren(json, node, position, matched, visit);
+
+    for (const auto& [step, child] : children) {
+      const auto next = child;
+      if (!Walker::step(json, position, step, [&](size_t member) {
+            return walk(json, next, member, matched, visit);
+          }))
+        return false;
+    }
+    return true;
+  }
+
+  // Takes every step from `node` in one pass over the members or elements
+  // of the value at `position`. Names are compared by hash first. As in
+  // PathWalker::step(), a name selects only the first member of that name.
+  template <typename Index, typename Visit>
+  [[nodiscard]] auto walkChildren(const BasicJson<Index>& json, size_t node,
+                                  size_t position,
+                                  std::vector<uint8_t>& matched,
+                                  const Visit& visit) const -> bool {
+    using Walker = internal::PathWalker<Index>;
+    const auto& children = nodes_[node].children;
+    const auto object =
+        Walker::type(json, position) == internal::EntryType::Object;
+    // Steps below `base` belong to the callers.
+    const auto base = matched.size();
+    matched.resize(base + children.size());
+    auto unmatched = children.size() - (nodes_[node].wildcard ? 1 : 0);
+    auto stopped = false;
+
+    static_cast<void>(Walker::children(
+        json, position, [&](size_t member, size_t offset) {
+          std::string_view name;
+          uint64_t hash = 0;
+          if (object) {
+            name = Walker::name(json, member);
+            hash = internal::hashKey(name);
+          }
+          for (size_t i = 0; i != children.size(); ++i) {
+            const auto& [step, child] = children[i];
+            if (!step.wildcard) {
+              if (matched[base + i] != 0) continue;
+              if (object ? step.hash != hash || step.key != name
+                         : step.index != offset)
+                continue;
+              matched[base + i] = 1;
+              --unmatched;
+            }
+            if (!walk(json, child, member, matched, visit)) {
+              stopped = true;
+              return false;
+            }
+          }
+          // Without "*", the rest of the members cannot match.
+          return unmatched != 0 || nodes_[node].wildcard;
+        }));
+    matched.resize(base);
+    return !stopped;
+  }
+};
+
+}  // namespace json
+
+#endif  // PATH_HH
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/path.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+// The examples of RFC 6901, section 5.
+constexpr std::string_view Example = R"({
+  "foo": ["bar", "baz"],
+  "": 0,
+  "a/b": 1,
+  "c%d": 2,
+  "e^f": 3,
+  "g|h": 4,
+  "i\\j": 5,
+  "k\"l": 6,
+  " ": 7,
+  "m~n": 8
+})";
+
+}  // namespace
+
+TEST(Path_FindsTheExamplesOfRfc6901) {
+  for (const auto threshold : {0U, 1U}) {
+    const auto json =
+        json::Json::parse(Example, {.key_index_threshold = threshold});
+    ASSERT_TRUE(json);
+
+    const auto find = [&](std::string_view pointer) {
+      return json::Path::compile(pointer)->find(*json);
+    };
+    EXPECT_TRUE(find("") == json->begin());
+    EXPECT_EQ(find("/foo").size(), 2U);
+    EXPECT_EQ(find("/foo/0").string(), std::string_view{"bar"});
+    EXPECT_EQ(find("/foo/1").string(), std::string_view{"baz"});
+    EXPECT_EQ(find("/").integer(), int64_t{0});
+    EXPECT_EQ(find("/a~1b").integer(), int64_t{1});
+    EXPECT_EQ(find("/c%d").integer(), int64_t{2});
+    EXPECT_EQ(find("/e^f").integer(), int64_t{3});
+    EXPECT_EQ(find("/g|h").integer(), int64_t{4});
+    EXPECT_EQ(find(R"(/i\j)").integer(), int64_t{5});
+    EXPECT_EQ(find(R"(/k"l)").integer(), int64_t{6});
+    EXPECT_EQ(find("/ ").integer(), int64_t{7});
+    EXPECT_EQ(find("/m~0n").integer(), int64_t{8});
+    EXPECT_EQ(find("/m~0n").name(), std::string_view{"m~n"});
+
+    EXPECT_TRUE(find("/foo/2") == json->end());
+    EXPECT_TRUE(find("/foo/-") == json->end());
+    EXPECT_TRUE(find("/foo/01") == json->end());
+    EXPECT_TRUE(find("/missing") == json->end());
+    EXPECT_TRUE(find("/foo/0/deeper") == json->end());
+  }
+}
+
+TEST(Path_RejectsInvalidPointers) {
+  EXPECT_EQ(json::Path::compile("foo").status(),
+            json::Status::UnexpectedCharacter);
+  EXPECT_EQ(json::Path::compile("/a~2").status(),
+            json::Status::UnexpectedCharacter);
+  EXPECT_EQ(json::Path::compile("/a~").status(),
+            json::Status::UnexpectedCharacter);
+}
+
+TEST(Path_MatchesNamesThatLookLikeIndices) {
+  const auto json = json::Json::parse(R"({"0": {"12": true}, "a": [[1, 2]]})");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json::Path::compile("/0/12")->find(*json).boolean(), true);
+  EXPECT_EQ(json::Path::compile("/a/0/1")->find(*json).integer(), int64_t{2});
+}
+
+TEST(Path_ExpandsWildcards) {
+  const auto json = json::Json::parse(
+      R"({"users": [{"name": "a", "id": 1}, {"id": 2}, {"name": "c"}]})");
+  ASSERT_TRUE(json);
+
+  const auto names = json::Path::compile("/users/*/name");
+  ASSERT_TRUE(names);
+  std::string found;
+  names->forEach(*json, [&](const auto& value) { found += *value.string(); });
+  EXPECT_EQ(found, "ac");
+  EXPECT_EQ(names->find(*json).string(), std::string_view{"a"});
+
+  const auto fields = json::Path::compile("/users/0/*");
+  found.clear();
+  fields->forEach(*json, [&](const auto& value) { found += *value.name(); });
+  EXPECT_EQ(found, "nameid");
+}
+
+TEST(PathSet_FindsAllPathsInOneWalk) {
+  const auto json = json::Json::parse(
+      R"({"a": {"b": 1, "c": [10, 20]}, "d": "x", "e": [{"f": 1}, {"f": 2}]})");
+  ASSERT_TRUE(json);
+
+  json::PathSet paths;
+  for (const auto* pointer : {"/a/b", "/a/c/1", "/d", "/missing", "/e/*/f",
+                              "/a/b", ""})
+    paths.add(*json::Path::compile(pointer));
+  ASSERT_EQ(paths.size(), 7U);
+
+  std::vector<json::Json::value_iterator> results;
+  paths.find(*json, results);
+  ASSERT_EQ(results.size(), 7U);
+  EXPECT_EQ(results[0].integer(), int64_t{1});
+  EXPECT_EQ(results[1].integer(), int64_t{20});
+  EXPECT_EQ(results[2].string(), std::string_view{"x"});
+  EXPECT_TRUE(results[3] == json->end());
+  EXPECT_EQ(results[4].integer(), int64_t{1});
+  EXPECT_EQ(results[5].integer(), int64_t{1});
+  EXPECT_TRUE(results[6] == json->begin());
+
+  int64_t sum = 0;
+  paths.forEach(*json, [&](size_t path, const auto& value) {
+    if (path == 4) sum += *value.integer();
+  });
+  EXPECT_EQ(sum, 3);
+}
+
+TEST(PathSet_MatchesSiblingsInOnePass) {
+  for (const auto threshold : {0U, 1U}) {
+    const auto json = json::Json::parse(
+        R"({"a": 1, "b\"": 2, "a": 3, "c": [4, 5, 6], "d": 7})",
+        {.borrow_source = true, .key_index_threshold = threshold});
+    ASSERT_TRUE(json);
+
+    json::PathSet paths;
+    for (const auto* pointer : {"/d", "/a", "/b\"", "/c/2", "/c/*", "/c/0",
+                                "/missing"})
+      paths.add(*json::Path::compile(pointer));
+
+    std::vector<json::Json::value_iterator> results;
+    paths.find(*json, results);
+    EXPECT_EQ(results[0].integer(), int64_t{7});
+    // Only the first of two members with the same name.
+    EXPECT_EQ(results[1].integer(), int64_t{1});
+    EXPECT_EQ(results[2].integer(), int64_t{2});
+    EXPECT_EQ(results[3].integer(), int64_t{6});
+    EXPECT_EQ(results[4].integer(), int64_t{4});
+    EXPECT_EQ(results[5].integer(), int64_t{4});
+    EXPECT_TRUE(results[6] == json->end());
+
+    std::string found;
+    paths.forEach(*json, [&](size_t path, const auto& value) {
+      found += std::to_string(path) + ":" + std::to_string(*value.integer()) +
+               " ";
+    });
+    // The values of each path in document order; indexed members in the
+    // order of the paths.
+    EXPECT_EQ(found, threshold == 0 ? "1:1 2:2 4:4 5:4 4:5 3:6 4:6 0:7 "
+                                    : "0:7 1:1 2:2 4:4 5:4 4:5 3:6 4:6 ");
+  }
+}
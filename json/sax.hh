@@ -0,0 +1,114 @@
+#ifndef SAX_HH
+#define SAX_HH
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "json/character_utils.hh"
+#include "json/event_parser.hh"
+#include "json/number_scanner.hh"
+#include "json/status.hh"
+
+namespace json {
+
+// Receives the values of a document in document order, from
+// json::parseEvents(). Derive from it and hide the events of interest; the
+// others do nothing:
+//
+//   struct Sum : json::SaxHandler {
+//     double total = 0;
+//     void onNumber(double value) { total += value; }
+//   };
+//
+// Keys and strings are unescaped, and only valid during the call. Handlers
+// that declare onInteger(int64_t) or onUInt64(uint64_t) receive integers
+// that fit those exactly instead of through onNumber().
+struct SaxHandler {
+  void onObjectStart() {}
+  void onObjectEnd() {}
+  void onArrayStart() {}
+  void onArrayEnd() {}
+  void onKey(std::string_view /*key*/) {}
+  void onString(std::string_view /*value*/) {}
+  void onNumber(double /*value*/) {}
+  void onBoolean(bool /*value*/) {}
+  void onNull() {}
+};
+
+namespace internal {
+
+// Unescapes keys and strings for a SaxHandler, reusing one buffer.
+template <typename Handler>
+class UnescapingHandler {
+  Handler& handler_;
+  std::string unescaped_;
+
+  [[nodiscard]] auto unescaped(std::string_view text, bool& valid)
+      -> std::string_view {
+    valid = true;
+    if (text.find('\\') == std::string_view::npos) return text;
+    unescaped_.clear();
+    valid = unescape(text, unescaped_);
+    return unescaped_;
+  }
+
+ public:
+  explicit UnescapingHandler(Handler& handler) : handler_{handler} {}
+
+  void onObjectStart() { handler_.onObjectStart(); }
+  void onObjectEnd() { handler_.onObjectEnd(); }
+  void onArrayStart() { handler_.onArrayStart(); }
+  void onArrayEnd() { handler_.onArrayEnd(); }
+  void onNumber(ScannedNumber number) {
+    using Kind = ScannedNumber::Kind;
+    if constexpr (requires { handler_.onInteger(int64_t{}); }) {
+      if (number.kind == Kind::Integer) {
+        handler_.onInteger(number.integer());
+        return;
+      }
+    }
+    if constexpr (requires { handler_.onUInt64(uint64_t{}); }) {
+      if (number.kind == Kind::UInt64) {
+        handler_.onUInt64(number.uint64());
+        return;
+      }
+    }
+    handler_.onNumber(number.real());
+  }
+  void onBoolean(bool value) { handler_.onBoolean(value); }
+  void onNull() { handler_.onNull(); }
+
+  [[nodiscard]] auto onKey(std::string_view text) -> Status {
+    bool valid{};
+    const auto key = unescaped(text, valid);
+    if (!valid) return Status::UnexpectedCharacter;
+    handler_.onKey(key);
+    return Status::Ok;
+  }
+
+  [[nodiscard]] auto onString(std::string_view text) -> Status {
+    bool valid{};
+    const auto value = unescaped(text, valid);
+    if (!valid) return Status::UnexpectedCharacter;
+    handler_.onString(value);
+    return Status::Ok;
+  }
+};
+
+}  // namespace internal
+
+// Parses `json_source` and reports every value to `handler` without
+// building a document. Accepts exactly what Json::parse() accepts; on
+// errors, the handler has seen the events up to the error. Memory use only
+// depends on the nesting depth of the document.
+template <typename Handler>
+[[nodiscard]] auto parseEvents(std::string_view json_source, Handler& handler)
+    -> Status {
+  internal::EventParser parser{internal::UnescapingHandler<Handler>{handler}};
+  return parser.parse(json_source);
+}
+
+}  // namespace json
+
+#endif  // SAX_HH
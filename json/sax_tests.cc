@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "json/sax.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+// Writes events in a compact notation.
+struct Recorder : json::SaxHandler {
+  std::string events;
+
+  void onObjectStart() { events += "{"; }
+  void onObjectEnd() { events += "}"; }
+  void onArrayStart() { events += "["; }
+  void onArrayEnd() { events += "]"; }
+  void onKey(std::string_view key) { events += "k:" + std::string{key} + " "; }
+  void onString(std::string_view value) {
+    events += "s:" + std::string{value} + " ";
+  }
+  void onNumber(double value) { events += "n:" + std::to_string(value) + " "; }
+  void onBoolean(bool value) { events += value ? "true " : "false "; }
+  void onNull() { events += "null "; }
+};
+
+struct Sum : json::SaxHandler {
+  double total = 0;
+  void onNumber(double value) { total += value; }
+};
+
+}  // namespace
+
+TEST(Sax_ReportsEventsInDocumentOrder) {
+  Recorder recorder;
+  ASSERT_EQ(json::parseEvents(
+                R"({"a": [1, "x\ty"], "bA": {"c": null}, "d": true})",
+                recorder),
+            json::Status::Ok);
+  EXPECT_EQ(recorder.events,
+            "{k:a [n:1.000000 s:x\ty ]k:bA {k:c null }k:d true }");
+
+  Recorder unclosed;
+  ASSERT_EQ(json::parseEvents(R"([{"a": [false, {"b")", unclosed),
+            json::Status::Ok);
+  EXPECT_EQ(unclosed.events, "[{k:a [false {k:b }]}]");
+}
+
+TEST(Sax_ReportsErrors) {
+  Sum sum;
+  EXPECT_EQ(json::parseEvents("[1, 2, 3 4]", sum),
+            json::Status::UnexpectedToken);
+  EXPECT_EQ(sum.total, 6);
+  EXPECT_EQ(json::parseEvents(R"(["\q"])", sum),
+            json::Status::UnexpectedCharacter);
+}
+
+TEST(Sax_ReportsExactIntegersOnRequest) {
+  struct Integers : json::SaxHandler {
+    int64_t integers = 0;
+    uint64_t large = 0;
+    double reals = 0;
+    void onInteger(int64_t value) { integers += value; }
+    void onUInt64(uint64_t value) { large += value; }
+    void onNumber(double value) { reals += value; }
+  };
+
+  Integers handler;
+  ASSERT_EQ(
+      json::parseEvents("[9007199254740993, -3, 18446744073709551615, 0.5]",
+                        handler),
+      json::Status::Ok);
+  EXPECT_EQ(handler.integers, 9007199254740990);
+  EXPECT_EQ(handler.large, 18446744073709551615U);
+  EXPECT_EQ(handler.reals, 0.5);
+}
@@ -0,0 +1,187 @@
+#ifndef SCHEMA_DECODER_HH
+#define SCHEMA_DECODER_HH
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "json/binding.hh"
+#include "json/character_utils.hh"
+#include "json/number_scanner.hh"
+#include "json/serializer.hh"
+#include "json/status.hh"
+
+//
+// Decoding specialized for documents of one expected shape.
+//
+// The json::Fields of a struct describe its members in order. A decoder
+// instantiated for the struct expects exactly those members in that order,
+// so instead of looking a name up it compares the next one with the name it
+// expects, in one memcmp. Values go through a scanner for their field's
+// type: numbers are scanned in place, and strings are copied once their end
+// is found, 16 bytes at a time.
+//
+// Anything else, like members in another order, unknown or missing members,
+// or strings with escape sequences, makes the specialized decoder give up,
+// and the document is decoded by json::decode() instead. The result is the
+// same either way.
+//
+
+namespace json {
+
+namespace internal {
+
+// Scans the expected shape from the start of a document. Every function
+// returns false as soon as the input does not match it.
+class SchemaScanner {
+  const char* pos_;
+  const char* end_;
+
+ public:
+  explicit SchemaScanner(std::string_view json_source)
+      : pos_{json_source.data()}, end_{pos_ + json_source.size()} {}
+
+  template <typename T>
+  [[nodiscard]] auto document(T& value) -> bool {
+    return read(value) && (skipWhitespace(), pos_ == end_);
+  }
+
+ private:
+  void skipWhitespace() {
+    while (pos_ != end_ && isWhitespace(*pos_)) ++pos_;
+  }
+
+  // Skips whitespace and `chr`.
+  [[nodiscard]] auto consume(char chr) -> bool {
+    skipWhitespace();
+    if (pos_ == end_ || *pos_ != chr) return false;
+    ++pos_;
+    return true;
+  }
+
+  // Whitespace, then `text` as it is.
+  [[nodiscard]] auto consume(std::string_view text) -> bool {
+    skipWhitespace();
+    if (static_cast<size_t>(end_ - pos_) < text.size() ||
+        std::memcmp(pos_, text.data(), text.size()) != 0)
+      return false;
+    pos_ += text.size();
+    return true;
+  }
+
+  [[nodiscard]] auto number(ScannedNumber& number) -> std::string_view {
+    skipWhitespace();
+    const std::string_view rest{pos_, static_cast<size_t>(end_ - pos_)};
+    const auto length = scanNumber(rest, number);
+    pos_ += length;
+    return rest.substr(0, length);
+  }
+
+  // A member name, "name": with only whitespace in between.
+  [[nodiscard]] auto name(std::string_view expected) -> bool {
+    if (!consume('"')) return false;
+    if (static_cast<size_t>(end_ - pos_) <= expected.size() ||
+        std::memcmp(pos_, expected.data(), expected.size()) != 0 ||
+        pos_[expected.size()] != '"')
+      return false;
+    pos_ += expected.size() + 1;
+    return consume(':');
+  }
+
+  // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  template <typename T>
+  [[nodiscard]] auto read(T& value) -> bool {
+    if constexpr (OptionalValue<T>) {
+      if (consume("null")) {
+        value.reset();
+        return true;
+      }
+      if (!value) value.emplace();
+      return read(*value);
+    } else if constexpr (std::same_as<T, bool>) {
+      if (consume("true")) {
+        value = true;
+        return true;
+      }
+      value = false;
+      return consume("false");
+    } else if constexpr (IntegerValue<T>) {
+      ScannedNumber scanned;
+      const auto text = number(scanned);
+      if (text.empty()) return false;
+      const auto integral = integralValue<T>(scanned, text);
+      if (integral) value = *integral;
+      return integral.has_value();
+    } else if constexpr (std::floating_point<T>) {
+      ScannedNumber scanned;
+      if (number(scanned).empty()) return false;
+      value = static_cast<T>(scanned.real());
+      return true;
+    } else if constexpr (std::same_as<T, std::string>) {
+      if (!consume('"')) return false;
+      const std::string_view rest{pos_, static_cast<size_t>(end_ - pos_)};
+      // Escape sequences are left to the generic decoder.
+      const auto end = findEscape(rest, 0);
+      if (end == std::string_view::npos || rest[end] != '"') return false;
+      value.assign(pos_, end);
+      pos_ += end + 1;
+      return true;
+    } else if constexpr (VectorValue<T>) {
+      if (!consume('[')) return false;
+      value.clear();
+      if (consume(']')) return true;
+      do {
+        // As in json::decode(), not into a std::vector<bool> proxy.
+        typename T::value_type element{};
+        if (!read(element)) return false;
+        value.push_back(std::move(element));
+      } while (consume(','));
+      return consume(']');
+    } else if constexpr (Bound<T>) {
+      if (!consume('{')) return false;
+      bool first = true;
+      const auto members = std::apply(
+          [&](const auto&... fields) {
+            return (... && ((first || consume(',')) &&
+                            (first = false, name(fields.key.name())) &&
+                            read(value.*fields.member)));
+          },
+          Fields<T>::list);
+      return members && consume('}');
+    } else {
+      // Decoded by json::decode() only.
+      return false;
+    }
+  }
+};
+
+}  // namespace internal
+
+// Decodes `json_source` into `value` like json::decode(), specialized for
+// documents that have exactly the members of json::Fields, in that order,
+// at every level. Fields the document does not mention are left value
+// initialized.
+template <typename T>
+[[nodiscard]] auto decodeSchema(std::string_view json_source, T& value)
+    -> Status {
+  internal::SchemaScanner scanner{json_source};
+  if (scanner.document(value)) return Status::Ok;
+  value = T{};
+  return decode(json_source, value);
+}
+
+template <typename T>
+[[nodiscard]] auto decodeSchema(std::string_view json_source) -> StatusOr<T> {
+  T value{};
+  auto status = decodeSchema(json_source, value);
+  if (status != Status::Ok) return status;
+  return value;
+}
+
+}  // namespace json
+
+#endif  // SCHEMA_DECODER_HH
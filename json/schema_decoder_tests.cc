@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "json/binding.hh"
+#include "json/schema_decoder.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+struct Item {
+  std::string sku;
+  uint32_t count{};
+
+  auto operator==(const Item&) const -> bool = default;
+};
+
+struct Order {
+  int64_t id{};
+  std::string user;
+  double price{};
+  bool express{};
+  std::optional<std::string> note;
+  std::vector<Item> items;
+
+  auto operator==(const Order&) const -> bool = default;
+};
+
+constexpr std::string_view Expected = R"({
+  "id": 17, "user": "someone", "price": 12.5, "express": true,
+  "note": null, "items": [{"sku": "A-1", "count": 2}, {"sku": "B", "count": 1}]
+})";
+
+}  // namespace
+
+template <>
+struct json::Fields<Item> {
+  static constexpr auto list = std::tuple{json::field("sku", &Item::sku),
+                                          json::field("count", &Item::count)};
+};
+
+template <>
+struct json::Fields<Order> {
+  static constexpr auto list =
+      std::tuple{json::field("id", &Order::id),
+                 json::field("user", &Order::user),
+                 json::field("price", &Order::price),
+                 json::field("express", &Order::express),
+                 json::field("note", &Order::note),
+                 json::field("items", &Order::items)};
+};
+
+TEST(SchemaDecoder_ScansTheExpectedShape) {
+  Order order;
+  json::internal::SchemaScanner scanner{Expected};
+  ASSERT_TRUE(scanner.document(order));
+  EXPECT_EQ(order, *json::decode<Order>(Expected));
+  EXPECT_EQ(order.items[1].sku, "B");
+  EXPECT_EQ(*json::decodeSchema<Order>(Expected), order);
+
+  json::internal::SchemaScanner bits_scanner{"[true,false]"};
+  std::vector<bool> bits;
+  ASSERT_TRUE(bits_scanner.document(bits));
+  EXPECT_TRUE(bits == (std::vector<bool>{true, false}));
+
+  json::internal::SchemaScanner zero_scanner{"-0"};
+  int32_t zero = 1;
+  ASSERT_TRUE(zero_scanner.document(zero));
+  EXPECT_EQ(zero, 0);
+}
+
+TEST(SchemaDecoder_FallsBackOnOtherShapes) {
+  const auto expected = *json::decode<Order>(Expected);
+  for (const auto* source : {
+           // Members in another order, an escape, an unknown member.
+           R"({"user": "someone", "id": 17, "price": 12.5, "express": true,
+               "note": null, "items": [{"sku": "A-1", "count": 2},
+                                       {"sku": "B", "count": 1}]})",
+           R"({"id": 17, "user": "s\u006fmeone", "price": 12.5,
+               "express": true, "note": null, "items": [
+               {"sku": "A-1", "count": 2}, {"sku": "B", "count": 1}]})",
+           R"({"id": 17, "user": "someone", "price": 12.5, "express": true,
+               "extra": [1, 2], "note": null, "items": [
+               {"sku": "A-1", "count": 2}, {"sku": "B", "count": 1}]})",
+       }) {
+    Order order;
+    json::internal::SchemaScanner scanner{source};
+    EXPECT_FALSE(scanner.document(order));
+    const auto decoded = json::decodeSchema<Order>(source);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(*decoded, expected);
+  }
+
+  // Missing members are left value initialized.
+  Order order;
+  order.id = 5;
+  ASSERT_EQ(json::decodeSchema(R"({"user": "u"})", order), json::Status::Ok);
+  EXPECT_EQ(order.id, 0);
+  EXPECT_EQ(order.user, "u");
+}
+
+TEST(SchemaDecoder_ReportsTheErrorsOfDecode) {
+  for (const auto* source :
+       {R"({"id": 1.5})", R"({"id": 1, "user": "x")", R"({"id": 1} 2)",
+        R"({"id": 1, "user": "x", "price": 1, "express": true, "note": 3,
+            "items": []})",
+        R"({"id": 1, "user": "x", "price": 1, "express": true, "note": "n",
+            "items": [{"sku": "s", "count": -1}]})"}) {
+    EXPECT_EQ(json::decodeSchema<Order>(source).status(),
+              json::decode<Order>(source).status());
+  }
+}
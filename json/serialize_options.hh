@@ -0,0 +1,18 @@
+#ifndef SERIALIZE_OPTIONS_HH
+#define SERIALIZE_OPTIONS_HH
+
+namespace json {
+
+struct SerializeOptions {
+  // Put every member and element on a line of its own, indented by its
+  // depth, and a space after every colon. Empty containers stay "{}" and
+  // "[]". Without it, the output has no whitespace at all.
+  bool pretty = false;
+
+  // Spaces per level of nesting when pretty printing.
+  unsigned indent = 2;
+};
+
+}  // namespace json
+
+#endif  // SERIALIZE_OPTIONS_HH
@@ -0,0 +1,343 @@
+#ifndef SERIALIZER_HH
+#define SERIALIZER_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/number_scanner.hh"
+#include "json/serialize_options.hh"
+#include "json/status.hh"
+#include "json/tape.hh"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//
+// Writes documents, or any value in them, back out as JSON.
+//
+// The tape is written front to back in one pass, keeping only a stack of the
+// containers that are still open. Text is copied in runs between the
+// characters that need escaping, which are found 16 bytes at a time.
+// Strings come out the same whether the document borrowed its source or
+// not. Numbers are written exactly as integers, or as the shortest text that
+// reads back as the same double.
+//
+
+namespace json {
+
+namespace internal {
+
+//" All code points may be placed within the quotation marks except for the
+//" code points that must be escaped: quotation mark (U+0022), reverse
+//" solidus (U+005C), and the control characters U+0000 to U+001F.
+inline constexpr auto NeedsEscape = [] {
+  std::array<bool, 256> characters{};
+  for (size_t chr = 0; chr != 0x20; ++chr) characters[chr] = true;
+  characters['"'] = true;
+  characters['\\'] = true;
+  return characters;
+}();
+
+// Position of the first character at or after `pos` that needs escaping.
+[[nodiscard]] inline auto findEscape(std::string_view text, size_t pos)
+    -> size_t {
+#if defined(__SSE2__)
+  // NOLINTBEGIN(portability-simd-intrinsics)
+  const auto quote = _mm_set1_epi8('"');
+  const auto backslash = _mm_set1_epi8('\\');
+  const auto last_control = _mm_set1_epi8(0x1F);
+  for (; pos + 16 <= text.size(); pos += 16) {
+    const auto chunk = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(text.data() + pos));  // NOLINT
+    // Unsigned bytes up to 0x1F are their own minimum with 0x1F.
+    const auto control =
+        _mm_cmpeq_epi8(_mm_min_epu8(chunk, last_control), chunk);
+    const auto special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                      _mm_cmpeq_epi8(chunk, backslash));
+    const auto mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_or_si128(control, special)));
+    if (mask != 0) return pos + static_cast<size_t>(std::countr_zero(mask));
+  }
+  // NOLINTEND(portability-simd-intrinsics)
+#endif
+  for (; pos != text.size(); ++pos) {
+    if (NeedsEscape[static_cast<unsigned char>(text[pos])]) return pos;
+  }
+  return std::string_view::npos;
+}
+
+// Appends to a string, which grows as needed.
+class StringOutput {
+  std::string& out_;
+
+ public:
+  explicit StringOutput(std::string& out) : out_{out} {}
+
+  void write(std::string_view text) { out_.append(text); }
+  void write(char chr) { out_.push_back(chr); }
+  void fill(size_t count, char chr) { out_.append(count, chr); }
+};
+
+// Writes into a fixed buffer, dropping whatever does not fit.
+class BufferOutput {
+  std::span<char> buffer_;
+  size_t size_{};
+  bool overflow_{};
+
+ public:
+  explicit BufferOutput(std::span<char> buffer) : buffer_{buffer} {}
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+  [[nodiscard]] auto overflow() const -> bool { return overflow_; }
+
+  void write(std::string_view text) {
+    if (!reserve(text.size())) return;
+    text.copy(buffer_.data() + size_, text.size());
+    size_ += text.size();
+  }
+
+  void write(char chr) {
+    if (reserve(1)) buffer_[size_++] = chr;
+  }
+
+  void fill(size_t count, char chr) {
+    if (!reserve(count)) return;
+    std::fill_n(buffer_.data() + size_, count, chr);
+    size_ += count;
+  }
+
+ private:
+  [[nodiscard]] auto reserve(size_t count) -> bool {
+    overflow_ = overflow_ || count > buffer_.size() - size_;
+    return !overflow_;
+  }
+};
+
+// Writes the escape sequence for `chr`, one of the NeedsEscape characters.
+template <typename Output>
+void writeEscape(char chr, Output& out) {
+  static constexpr std::string_view Hex = "0123456789abcdef";
+  switch (chr) {
+    case '"':
+      out.write(R"(\")");
+      break;
+    case '\\':
+      out.write(R"(\\)");
+      break;
+    case '\b':
+      out.write(R"(\b)");
+      break;
+    case '\f':
+      out.write(R"(\f)");
+      break;
+    case '\n':
+      out.write(R"(\n)");
+      break;
+    case '\r':
+      out.write(R"(\r)");
+      break;
+    case '\t':
+      out.write(R"(\t)");
+      break;
+    default: {
+      const std::array<char, 6> escape{
+          '\\', 'u', '0', '0', Hex[static_cast<unsigned char>(chr) >> 4],
+          Hex[static_cast<unsigned char>(chr) & 0xF]};
+      out.write(std::string_view{escape.data(), escape.size()});
+      break;
+    }
+  }
+}
+
+template <typename Output>
+void writeEscaped(std::string_view text, Output& out) {
+  out.write('"');
+  for (size_t pos = 0; pos != text.size();) {
+    const auto special = findEscape(text, pos);
+    if (special == std::string_view::npos) {
+      out.write(text.substr(pos));
+      break;
+    }
+    out.write(text.substr(pos, special - pos));
+    writeEscape(text[special], out);
+    pos = special + 1;
+  }
+  out.write('"');
+}
+
+// JSON has no representation for infinities and NaN; they are written as
+// null. Doubles with integral values get a ".0", so that they read back as
+// doubles rather than as integers.
+template <typename Output>
+void writeNumber(ScannedNumber number, Output& out) {
+  std::array<char, 32> text{};
+  std::to_chars_result result{};
+  switch (number.kind) {
+    case ScannedNumber::Kind::Integer:
+      result = std::to_chars(text.begin(), text.end(), number.integer());
+      break;
+    case ScannedNumber::Kind::UInt64:
+      result = std::to_chars(text.begin(), text.end(), number.uint64());
+      break;
+    case ScannedNumber::Kind::Double:
+      if (!std::isfinite(number.real())) {
+        out.write("null");
+        return;
+      }
+      result = std::to_chars(text.begin(), text.end(), number.real());
+      if (std::find_if(text.data(), result.ptr, [](char chr) {
+            return chr == '.' || chr == 'e';
+          }) == result.ptr) {
+        out.write(std::string_view{text.data(), result.ptr});
+        out.write(".0");
+        return;
+      }
+      break;
+  }
+  out.write(std::string_view{text.data(), result.ptr});
+}
+
+template <typename Index>
+class Serializer {
+  using Entry = TapeEntry<Index>;
+
+  // A container that is still open, and the tape index after its subtree.
+  struct Frame {
+    size_t end;
+    char closing;
+    bool empty;
+  };
+
+ public:
+  // Writes the value `value` refers to, with its subtree.
+  template <typename Output>
+  static void write(const ValueIterator<BasicJson<Index>>& value,
+                    const SerializeOptions& options, Output& out) {
+    auto [document, idx] = BasicJson<Index>::locate(value);
+    const auto& json = *document;
+    const auto entries = json.entries();
+    if (idx >= entries.size()) return;
+
+    const auto end = idx + 1 + entries[idx].size();
+    std::vector<Frame> open;
+    bool after_key = false;
+    while (idx != end) {
+      const auto& entry = entries[idx++];
+
+      if (!open.empty() && !after_key) {
+        if (!open.back().empty) out.write(',');
+        open.back().empty = false;
+        newLine(open.size(), options, out);
+      }
+      after_key = false;
+
+      switch (entry.type()) {
+        case EntryType::Object:
+        case EntryType::Array: {
+          const auto is_object = entry.type() == EntryType::Object;
+          out.write(is_object ? '{' : '[');
+          open.push_back({idx + entry.size(), is_object ? '}' : ']', true});
+          break;
+        }
+        case EntryType::Key:
+          writeText(json, entry, out);
+          out.write(options.pretty ? ": " : ":");
+          after_key = true;
+          break;
+        case EntryType::String:
+          writeText(json, entry, out);
+          break;
+        case EntryType::Number:
+        case EntryType::Integer:
+        case EntryType::UInt64:
+          writeNumber(entry.scannedNumber(), out);
+          break;
+        case EntryType::Boolean:
+          out.write(entry.boolean() ? "true" : "false");
+          break;
+        case EntryType::Null:
+          out.write("null");
+          break;
+      }
+
+      while (!open.empty() && open.back().end == idx) {
+        const auto frame = open.back();
+        open.pop_back();
+        if (!frame.empty) newLine(open.size(), options, out);
+        out.write(frame.closing);
+      }
+    }
+  }
+
+ private:
+  template <typename Output>
+  static void newLine(size_t depth, const SerializeOptions& options,
+                      Output& out) {
+    if (!options.pretty) return;
+    out.write('\n');
+    out.fill(depth * options.indent, ' ');
+  }
+
+  // Borrowed text with escape sequences is written from its unescaped
+  // copy, so that borrowing does not change the output.
+  template <typename Output>
+  static void writeText(const BasicJson<Index>& json, const Entry& entry,
+                        Output& out) {
+    writeEscaped(json.text(entry), out);
+  }
+};
+
+}  // namespace internal
+
+// Appends `value`, with everything in it, to `out` as JSON. Writing many
+// values into the same string reuses its capacity.
+template <typename Index>
+void serializeInto(const ValueIterator<BasicJson<Index>>& value,
+                   std::string& out, const SerializeOptions& options = {}) {
+  internal::StringOutput output{out};
+  internal::Serializer<Index>::write(value, options, output);
+}
+
+// Writes `value` into `buffer`. Returns the number of bytes written, or
+// BufferTooSmall, with the buffer's contents undefined, if they do not fit.
+template <typename Index>
+[[nodiscard]] auto serializeInto(const ValueIterator<BasicJson<Index>>& value,
+                                 std::span<char> buffer,
+                                 const SerializeOptions& options = {})
+    -> StatusOr<size_t> {
+  internal::BufferOutput output{buffer};
+  internal::Serializer<Index>::write(value, options, output);
+  if (output.overflow()) return Status::BufferTooSmall;
+  return output.size();
+}
+
+template <typename Index>
+[[nodiscard]] auto serialize(const ValueIterator<BasicJson<Index>>& value,
+                             const SerializeOptions& options = {})
+    -> std::string {
+  std::string out;
+  serializeInto(value, out, options);
+  return out;
+}
+
+template <typename Index>
+[[nodiscard]] auto serialize(const BasicJson<Index>& json,
+                             const SerializeOptions& options = {})
+    -> std::string {
+  return serialize(json.begin(), options);
+}
+
+}  // namespace json
+
+#endif  // SERIALIZER_HH
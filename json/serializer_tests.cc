@@ -0,0 +1,127 @@
+#include <array>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "json/json.hh"
+#include "json/serializer.hh"
+#include "testrunner/testrunner.h"
+
+TEST(Serializer_WritesCompactJson) {
+  const auto json = json::Json::parse(
+      R"( { "a" : [ 1, -2.5, "x" ], "b": {}, "c": [ ], "d": null,
+            "e": true, "f": false } )");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json::serialize(*json),
+            R"({"a":[1,-2.5,"x"],"b":{},"c":[],"d":null,"e":true,"f":false})");
+}
+
+TEST(Serializer_WritesPrettyJson) {
+  const auto json =
+      json::Json::parse(R"({"a": [1, {"b": null}], "c": {}, "d": []})");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json::serialize(*json, {.pretty = true}),
+            "{\n"
+            "  \"a\": [\n"
+            "    1,\n"
+            "    {\n"
+            "      \"b\": null\n"
+            "    }\n"
+            "  ],\n"
+            "  \"c\": {},\n"
+            "  \"d\": []\n"
+            "}");
+  EXPECT_EQ(json::serialize(*json, {.pretty = true, .indent = 1}).substr(0, 9),
+            "{\n \"a\": [");
+}
+
+TEST(Serializer_WritesScalarsAndEmptyDocuments) {
+  EXPECT_EQ(json::serialize(*json::Json::parse(R"("abc")")), R"("abc")");
+  EXPECT_EQ(json::serialize(*json::Json::parse("  true ")), "true");
+  EXPECT_EQ(json::serialize(*json::Json::parse("")), "");
+}
+
+TEST(Serializer_KeepsNumbersExact) {
+  const auto json = json::Json::parse(
+      "[9223372036854775807, -9223372036854775808, 18446744073709551615, "
+      "0.1, 1e300, -0, 5e-324, 1.0]");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json::serialize(*json),
+            "[9223372036854775807,-9223372036854775808,18446744073709551615,"
+            "0.1,1e+300,-0.0,5e-324,1.0]");
+
+  // Doubles stay doubles.
+  const auto again = json::Json::parse(json::serialize(*json));
+  ASSERT_TRUE(again);
+  EXPECT_TRUE(std::holds_alternative<json::Number>(again->begin()[7].value()));
+  EXPECT_FALSE(again->begin()[7].integer());
+}
+
+TEST(Serializer_EscapesStrings) {
+  const auto json = json::Json::parse(
+      R"(["q\"b\\s\/\b\f\n\r\t\u0001\u001fé long enough for a chunk\n"])");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(
+      json::serialize(*json),
+      R"(["q\"b\\s/\b\f\n\r\t\u0001\u001fé long enough for a chunk\n"])");
+
+  // Escapes at every position relative to the 16 byte chunks.
+  for (size_t length = 0; length != 40; ++length) {
+    const auto source = "[\"" + std::string(length, 'a') + R"(\"\n\\)" +
+                        std::string(length, 'b') + "\"]";
+    const auto parsed = json::Json::parse(source);
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(json::serialize(*parsed), source);
+  }
+}
+
+TEST(Serializer_WritesBorrowedStringsLikeOwnedOnes) {
+  constexpr std::string_view Source =
+      R"({"kA": "a\nb", "x": "\/", "a\u00e9": "\"\\", "\ud83d\ude00": 1})";
+  for (const auto borrow : {false, true}) {
+    const auto json = json::Json::parse(Source, {.borrow_source = borrow});
+    ASSERT_TRUE(json);
+    EXPECT_EQ(json::serialize(*json),
+              "{\"kA\":\"a\\nb\",\"x\":\"/\",\"a\xc3\xa9\":\"\\\"\\\\\","
+              "\"\xf0\x9f\x98\x80\":1}");
+  }
+}
+
+TEST(Serializer_EscapesRawControlCharactersInBothModes) {
+  // A raw 0x1F, 0x01 and tab, next to an escaped backslash.
+  constexpr std::string_view Source =
+      "{\"k\x1f\": [\"a\x01"
+      "b\", \"\\\\\t\"]}";
+  for (const auto borrow : {false, true}) {
+    const auto json = json::Json::parse(Source, {.borrow_source = borrow});
+    ASSERT_TRUE(json);
+    EXPECT_EQ(json::serialize(*json), R"({"k\u001f":["a\u0001b","\\\t"]})");
+  }
+}
+
+TEST(Serializer_WritesSubtrees) {
+  const auto json = json::Json::parse(R"({"a": {"b": [1, 2]}, "c": 3})");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json::serialize((*json)["a"]), R"({"b":[1,2]})");
+  EXPECT_EQ(json::serialize((*json)["a"]["b"]), "[1,2]");
+  EXPECT_EQ(json::serialize((*json)["c"]), "3");
+  EXPECT_EQ(json::serialize((*json)["missing"]), "");
+
+  std::string out = "prefix ";
+  json::serializeInto((*json)["a"]["b"], out);
+  EXPECT_EQ(out, "prefix [1,2]");
+}
+
+TEST(Serializer_WritesIntoBuffers) {
+  const auto json = json::Json::parse(R"({"a": [1, 2]})");
+  ASSERT_TRUE(json);
+
+  std::array<char, 13> buffer{};
+  const auto written = json::serializeInto(json->begin(), buffer);
+  ASSERT_TRUE(written);
+  EXPECT_EQ((std::string_view{buffer.data(), *written}), R"({"a":[1,2]})");
+
+  std::array<char, 5> small{};
+  EXPECT_EQ(json::serializeInto(json->begin(), small).status(),
+            json::Status::BufferTooSmall);
+}
@@ -10,6 +10,14 @@ enum class Status {
   UnexpectedCharacter,
   UnexpectedToken,
   Unimplemented,
+  DocumentTooLarge,
+  CannotReadFile,
+  BufferTooSmall,
+  InvalidStructure,
+  TypeMismatch,
+  CannotWriteFile,
+  InvalidCache,
+  CorruptCache,
 };
 
 template <typename T>
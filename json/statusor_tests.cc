@@ -1,4 +1,6 @@
 #include <cstdint>
+#include <string>
+#include <utility>
 
 #include "json/status.hh"
 #include "testrunner/testrunner.h"
@@ -24,3 +26,73 @@ TEST(StatusOr_CanDereferenceValue) {
   EXPECT_EQ(status_ab->a, 10)
   EXPECT_EQ(status_ab->b, 20)
 }
+
+TEST(StatusOr_CanBeCopiedAndMoved) {
+  auto value = json::StatusOr<std::string>{std::string(100, 'x')};
+  auto copy = value;
+  auto moved = std::move(value);
+  ASSERT_TRUE(copy);
+  ASSERT_TRUE(moved);
+  EXPECT_EQ(*moved, *copy);
+  EXPECT_EQ(moved.status(), json::Status::Ok);
+
+  moved = json::StatusOr<std::string>{json::Status::UnexpectedToken};
+  ASSERT_FALSE(moved);
+  EXPECT_EQ(moved.status(), json::Status::UnexpectedToken);
+  copy = moved;
+  ASSERT_FALSE(copy);
+  EXPECT_EQ(copy.status(), json::Status::UnexpectedToken);
+}
+
+namespace {
+
+// Copies throw while `fail` is set.
+struct Fragile {
+  static inline bool fail = false;
+  static inline int alive = 0;
+
+  Fragile() { ++alive; }
+  Fragile(const Fragile& /*other*/) {
+    if (fail) throw 0;
+    ++alive;
+  }
+  Fragile(Fragile&& /*other*/) noexcept { ++alive; }
+  auto operator=(const Fragile& /*other*/) -> Fragile& = default;
+  auto operator=(Fragile&& /*other*/) noexcept -> Fragile& = default;
+  ~Fragile() { --alive; }
+};
+
+}  // namespace
+
+TEST(StatusOr_SurvivesThrowingCopies) {
+  {
+    const auto source = json::StatusOr<Fragile>{Fragile{}};
+    auto with_value = json::StatusOr<Fragile>{Fragile{}};
+    auto with_status = json::StatusOr<Fragile>{json::Status::UnexpectedToken};
+    EXPECT_EQ(Fragile::alive, 2);
+
+    Fragile::fail = true;
+    auto threw = 0;
+    try {
+      with_value = source;
+    } catch (int) {
+      ++threw;
+    }
+    try {
+      with_status = source;
+    } catch (int) {
+      ++threw;
+    }
+    Fragile::fail = false;
+    EXPECT_EQ(threw, 2);
+    // Both are left as they were.
+    ASSERT_TRUE(with_value);
+    EXPECT_EQ(with_status.status(), json::Status::UnexpectedToken);
+    EXPECT_EQ(Fragile::alive, 2);
+
+    with_status = source;
+    ASSERT_TRUE(with_status);
+    EXPECT_EQ(Fragile::alive, 3);
+  }
+  EXPECT_EQ(Fragile::alive, 0);
+}
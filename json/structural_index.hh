@@ -0,0 +1,378 @@
+#ifndef STRUCTURAL_INDEX_HH
+#define STRUCTURAL_INDEX_HH
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "json/character_utils.hh"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JSON_HAS_X86_KERNELS 1
+#endif
+
+//
+// Stage one of a two stage parse, following the design of simdjson
+// (Langdale, Lemire: "Parsing Gigabytes of JSON per Second", 2019).
+//
+// The input is classified 64 bytes at a time into bitmasks of backslashes,
+// quotation marks, structural characters and whitespace. From those, the
+// escaped characters and the extent of every string are derived without
+// branching on the input. The index records the position of every structural
+// character outside of strings, both quotation marks of every string and the
+// first byte of every other token (numbers and literals).
+//
+// The parser then only visits indexed positions instead of scanning every
+// byte.
+//
+
+namespace json::internal {
+
+class StructuralIndex {
+ public:
+  enum class Kernel { Automatic, Scalar, Sse42, Avx2 };
+
+  // Positions are stored as 32 bit offsets, so the index can only be built
+  // for inputs smaller than 4 GiB.
+  [[nodiscard]] static constexpr auto fits(std::string_view source) -> bool {
+    return source.size() < std::numeric_limits<uint32_t>::max();
+  }
+
+  [[nodiscard]] static auto isSupported(Kernel kernel) -> bool {
+    switch (kernel) {
+      case Kernel::Automatic:
+      case Kernel::Scalar:
+        return true;
+#ifdef JSON_HAS_X86_KERNELS
+      case Kernel::Sse42:
+        return __builtin_cpu_supports("sse4.2");
+      case Kernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+#else
+      case Kernel::Sse42:
+      case Kernel::Avx2:
+        return false;
+#endif
+    }
+    return false;
+  }
+
+  [[nodiscard]] static auto build(std::string_view source,
+                                  Kernel kernel = Kernel::Automatic)
+      -> StructuralIndex {
+    StructuralIndex index;
+    index.rebuild(source, kernel);
+    return index;
+  }
+
+  // Replaces the index with one for `source`, reusing its storage.
+  void rebuild(std::string_view source, Kernel kernel = Kernel::Automatic) {
+    positions_.clear();
+    positions_.reserve(source.size() / 4);
+
+    Scanner scanner{positions_};
+    switch (kernel == Kernel::Automatic ? bestKernel() : kernel) {
+#ifdef JSON_HAS_X86_KERNELS
+      case Kernel::Avx2:
+        scanAvx2(source, scanner);
+        break;
+      case Kernel::Sse42:
+        scanSse42(source, scanner);
+        break;
+#endif
+      default:
+        scanScalar(source, scanner);
+        break;
+    }
+  }
+
+  [[nodiscard]] auto positions() const -> const std::vector<uint32_t>& {
+    return positions_;
+  }
+
+ private:
+  static constexpr size_t BlockSize = 64;
+
+  struct BlockMasks {
+    uint64_t backslash;
+    uint64_t quote;
+    uint64_t structural;
+    uint64_t whitespace;
+  };
+
+  // Turns the masks of consecutive blocks into positions, carrying the
+  // in-string, escape and token state across block boundaries.
+  class Scanner {
+   public:
+    explicit Scanner(std::vector<uint32_t>& positions)
+        : positions_{positions} {}
+
+    void next(const BlockMasks& masks, size_t offset) {
+      const auto escaped = escapedCharacters(masks.backslash);
+      const auto quote = masks.quote & ~escaped;
+
+      // Every bit from an opening quote up to (excluding) the matching
+      // closing quote is set.
+      const auto in_string = prefixXor(quote) ^ in_string_carry_;
+      in_string_carry_ = 0 - (in_string >> 63);
+
+      const auto structural = masks.structural & ~in_string;
+      const auto other =
+          ~(masks.structural | masks.whitespace | quote | in_string);
+      const auto token_start = other & ~((other << 1) | other_carry_);
+      other_carry_ = other >> 63;
+
+      append(structural | quote | token_start, offset);
+    }
+
+   private:
+    // Backslashes are rare, so escapes are resolved one backslash at a time.
+    auto escapedCharacters(uint64_t backslash) -> uint64_t {
+      auto escaped = escape_carry_;
+      escape_carry_ = 0;
+
+      backslash &= ~escaped;
+      while (backslash != 0) {
+        const auto bit = backslash & (0 - backslash);
+        if (bit == uint64_t{1} << 63) {
+          escape_carry_ = 1;
+        } else {
+          escaped |= bit << 1;
+        }
+        backslash &= ~(bit | (bit << 1));
+      }
+      return escaped;
+    }
+
+    [[nodiscard]] static auto prefixXor(uint64_t bits) -> uint64_t {
+      bits ^= bits << 1;
+      bits ^= bits << 2;
+      bits ^= bits << 4;
+      bits ^= bits << 8;
+      bits ^= bits << 16;
+      bits ^= bits << 32;
+      return bits;
+    }
+
+    void append(uint64_t bits, size_t offset) {
+      auto idx = positions_.size();
+      positions_.resize(idx + static_cast<size_t>(std::popcount(bits)));
+      while (bits != 0) {
+        positions_[idx++] =
+            static_cast<uint32_t>(offset + static_cast<size_t>(
+                                               std::countr_zero(bits)));
+        bits &= bits - 1;
+      }
+    }
+
+    std::vector<uint32_t>& positions_;
+    uint64_t in_string_carry_{};
+    uint64_t other_carry_{};
+    uint64_t escape_carry_{};
+  };
+
+  // The last partial block is padded with whitespace, which never changes
+  // the index.
+  [[nodiscard]] static auto paddedBlock(std::string_view tail)
+      -> std::array<char, BlockSize> {
+    std::array<char, BlockSize> block{};
+    block.fill(' ');
+    std::memcpy(block.data(), tail.data(), tail.size());
+    return block;
+  }
+
+  [[nodiscard]] static auto bestKernel() -> Kernel {
+    static const auto best = [] {
+      if (isSupported(Kernel::Avx2)) return Kernel::Avx2;
+      if (isSupported(Kernel::Sse42)) return Kernel::Sse42;
+      return Kernel::Scalar;
+    }();
+    return best;
+  }
+
+  [[nodiscard]] static auto classifyScalar(const char* block) -> BlockMasks {
+    BlockMasks masks{};
+    for (size_t idx = 0; idx != BlockSize; ++idx) {
+      const auto bit = uint64_t{1} << idx;
+      switch (classify(block[idx])) {
+        case CharClass::Whitespace:
+          masks.whitespace |= bit;
+          break;
+        case CharClass::Quote:
+          masks.quote |= bit;
+          break;
+        case CharClass::LeftSquareBracket:
+        case CharClass::LeftCurlyBracket:
+        case CharClass::RightSquareBracket:
+        case CharClass::RightCurlyBracket:
+        case CharClass::Colon:
+        case CharClass::Comma:
+          masks.structural |= bit;
+          break;
+        default:
+          if (block[idx] == '\\') masks.backslash |= bit;
+          break;
+      }
+    }
+    return masks;
+  }
+
+  static void scanScalar(std::string_view source, Scanner& scanner) {
+    size_t offset = 0;
+    for (; offset + BlockSize <= source.size(); offset += BlockSize)
+      scanner.next(classifyScalar(source.data() + offset), offset);
+    if (offset != source.size()) {
+      const auto block = paddedBlock(source.substr(offset));
+      scanner.next(classifyScalar(block.data()), offset);
+    }
+  }
+
+#ifdef JSON_HAS_X86_KERNELS
+  // Structural characters and whitespace are found with a pair of nibble
+  // lookups. Each table entry holds a bit for every character class whose
+  // members have that low (or high) nibble; a byte belongs to a class if both
+  // lookups agree:
+  //
+  //   bit 0: [ ] { }    (0x5B 0x5D 0x7B 0x7D)
+  //   bit 1: ,          (0x2C)
+  //   bit 2: :          (0x3A)
+  //   bit 3: space      (0x20)
+  //   bit 4: \t \n \r   (0x09 0x0A 0x0D)
+  //
+  static constexpr char StructuralBits = 0x07;
+  static constexpr char WhitespaceBits = 0x18;
+
+  // NOLINTBEGIN(portability-simd-intrinsics)
+  [[gnu::target("sse4.2")]] static void classify16(__m128i chunk,
+                                                   __m128i& structural,
+                                                   __m128i& whitespace) {
+    const auto low_table = _mm_setr_epi8(8, 0, 0, 0, 0, 0, 0, 0, 0, 16, 20, 1,
+                                         2, 17, 0, 0);
+    const auto high_table =
+        _mm_setr_epi8(16, 0, 10, 4, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+    const auto nibble = _mm_set1_epi8(0x0F);
+
+    const auto low = _mm_shuffle_epi8(low_table, _mm_and_si128(chunk, nibble));
+    const auto high = _mm_shuffle_epi8(
+        high_table, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble));
+    const auto classes = _mm_and_si128(low, high);
+    structural = _mm_and_si128(classes, _mm_set1_epi8(StructuralBits));
+    whitespace = _mm_and_si128(classes, _mm_set1_epi8(WhitespaceBits));
+  }
+
+  [[gnu::target("sse4.2")]] static auto nonZeroMask16(__m128i bytes)
+      -> uint64_t {
+    const auto zero = _mm_cmpeq_epi8(bytes, _mm_setzero_si128());
+    return ~static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(zero))) &
+           0xFFFF;
+  }
+
+  [[gnu::target("sse4.2")]] static auto equalMask16(__m128i bytes, char chr)
+      -> uint64_t {
+    return static_cast<uint16_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(chr))));
+  }
+
+  [[gnu::target("sse4.2")]] static auto classifySse42(const char* block)
+      -> BlockMasks {
+    BlockMasks masks{};
+    for (size_t idx = 0; idx != BlockSize / 16; ++idx) {
+      const auto chunk = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(block + idx * 16));  // NOLINT
+      __m128i structural;
+      __m128i whitespace;
+      classify16(chunk, structural, whitespace);
+
+      const auto shift = idx * 16;
+      masks.structural |= nonZeroMask16(structural) << shift;
+      masks.whitespace |= nonZeroMask16(whitespace) << shift;
+      masks.quote |= equalMask16(chunk, '"') << shift;
+      masks.backslash |= equalMask16(chunk, '\\') << shift;
+    }
+    return masks;
+  }
+
+  [[gnu::target("sse4.2")]] static void scanSse42(std::string_view source,
+                                                  Scanner& scanner) {
+    size_t offset = 0;
+    for (; offset + BlockSize <= source.size(); offset += BlockSize)
+      scanner.next(classifySse42(source.data() + offset), offset);
+    if (offset != source.size()) {
+      const auto block = paddedBlock(source.substr(offset));
+      scanner.next(classifySse42(block.data()), offset);
+    }
+  }
+
+  [[gnu::target("avx2")]] static auto nonZeroMask32(__m256i bytes)
+      -> uint64_t {
+    const auto zero = _mm256_cmpeq_epi8(bytes, _mm256_setzero_si256());
+    return ~static_cast<uint64_t>(static_cast<uint32_t>(
+               _mm256_movemask_epi8(zero))) &
+           0xFFFFFFFF;
+  }
+
+  [[gnu::target("avx2")]] static auto equalMask32(__m256i bytes, char chr)
+      -> uint64_t {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(chr))));
+  }
+
+  [[gnu::target("avx2")]] static auto classifyAvx2(const char* block)
+      -> BlockMasks {
+    // _mm256_shuffle_epi8 looks up each 128 bit lane separately, so both
+    // lanes carry a copy of the tables.
+    const auto low_table = _mm256_setr_epi8(
+        8, 0, 0, 0, 0, 0, 0, 0, 0, 16, 20, 1, 2, 17, 0, 0,  //
+        8, 0, 0, 0, 0, 0, 0, 0, 0, 16, 20, 1, 2, 17, 0, 0);
+    const auto high_table = _mm256_setr_epi8(
+        16, 0, 10, 4, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0,  //
+        16, 0, 10, 4, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+    const auto nibble = _mm256_set1_epi8(0x0F);
+
+    BlockMasks masks{};
+    for (size_t idx = 0; idx != BlockSize / 32; ++idx) {
+      const auto chunk = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(block + idx * 32));  // NOLINT
+      const auto low =
+          _mm256_shuffle_epi8(low_table, _mm256_and_si256(chunk, nibble));
+      const auto high = _mm256_shuffle_epi8(
+          high_table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble));
+      const auto classes = _mm256_and_si256(low, high);
+
+      const auto shift = idx * 32;
+      masks.structural |= nonZeroMask32(_mm256_and_si256(
+                              classes, _mm256_set1_epi8(StructuralBits)))
+                          << shift;
+      masks.whitespace |= nonZeroMask32(_mm256_and_si256(
+                              classes, _mm256_set1_epi8(WhitespaceBits)))
+                          << shift;
+      masks.quote |= equalMask32(chunk, '"') << shift;
+      masks.backslash |= equalMask32(chunk, '\\') << shift;
+    }
+    return masks;
+  }
+
+  [[gnu::target("avx2")]] static void scanAvx2(std::string_view source,
+                                               Scanner& scanner) {
+    size_t offset = 0;
+    for (; offset + BlockSize <= source.size(); offset += BlockSize)
+      scanner.next(classifyAvx2(source.data() + offset), offset);
+    if (offset != source.size()) {
+      const auto block = paddedBlock(source.substr(offset));
+      scanner.next(classifyAvx2(block.data()), offset);
+    }
+  }
+  // NOLINTEND(portability-simd-intrinsics)
+#endif
+
+  std::vector<uint32_t> positions_;
+};
+
+}  // namespace json::internal
+
+#endif  // STRUCTURAL_INDEX_HH
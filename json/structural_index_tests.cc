@@ -0,0 +1,90 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/parser.hh"
+#include "json/structural_index.hh"
+#include "testrunner/testrunner.h"
+
+using json::internal::StructuralIndex;
+
+namespace {
+
+auto documents() -> std::vector<std::string> {
+  std::vector<std::string> docs{
+      "",
+      "   ",
+      "null",
+      R"({"Hello": "Object"})",
+      R"([1, -2.5e3, true, false, null, "x", {}, []])",
+      R"({"a": {"b": [1, 2, {"c": "d"}]}, "e": "f"})",
+      R"({"escaped \"quote\"": "back\\slash\\", "t": "\\\"x"})",
+      R"({"Number": 25373547)",
+      R"([1 2])",
+      R"(["unterminated)",
+      R"(true1)",
+      R"(nullx)",
+      R"(12"ab")",
+      R"({"a" "b"})",
+      R"(@)",
+      R"(true true)",
+  };
+
+  // Move backslash runs, strings and tokens across the 64 byte block
+  // boundaries of the index.
+  for (size_t pad = 50; pad != 80; ++pad) {
+    for (size_t backslashes = 1; backslashes != 4; ++backslashes) {
+      std::string doc = "[" + std::string(pad, ' ') + "\"";
+      doc += std::string(backslashes, '\\') + "\"";
+      doc += backslashes % 2 == 0 ? "" : "\"";
+      doc += ", 12345, true, {\"key\": \"" + std::string(pad, 'x') + "\"}]";
+      docs.push_back(doc);
+    }
+  }
+  return docs;
+}
+
+}  // namespace
+
+TEST(StructuralIndex_IndexesStructuralCharactersAndTokens) {
+  const std::string_view source = R"({"a": [1, true, "b,]"]})";
+  auto index = StructuralIndex::build(source);
+
+  std::string indexed;
+  for (auto position : index.positions()) indexed += source[position];
+  EXPECT_EQ(indexed, R"({"":[1,t,""]})");
+}
+
+TEST(StructuralIndex_KernelsAgree) {
+  const auto docs = documents();
+  for (auto kernel : {StructuralIndex::Kernel::Sse42,
+                      StructuralIndex::Kernel::Avx2}) {
+    if (!StructuralIndex::isSupported(kernel)) continue;
+    for (const auto& doc : docs) {
+      EXPECT_TRUE(
+          StructuralIndex::build(doc, kernel).positions() ==
+          StructuralIndex::build(doc, StructuralIndex::Kernel::Scalar)
+              .positions());
+    }
+  }
+}
+
+TEST(StructuralIndex_ParserProducesIdenticalNodes) {
+  for (const auto& doc : documents()) {
+    json::internal::Parser<> sequential;
+    json::internal::Parser<> indexed;
+
+    auto sequential_status = sequential.parse(doc);
+    auto indexed_status = indexed.parse(doc, StructuralIndex::build(doc));
+    EXPECT_EQ(sequential_status, indexed_status);
+    EXPECT_TRUE(sequential.tape() == indexed.tape());
+  }
+}
+
+TEST(StructuralIndex_SelectableThroughParseOptions) {
+  auto json = json::Json::parse(R"({"Hello": {"World": "Earth"}})",
+                                {.structural_index = true});
+  ASSERT_TRUE(json);
+  EXPECT_EQ(*(*json)["Hello"]["World"].string(), "Earth");
+}
@@ -0,0 +1,233 @@
+#ifndef TAPE_HH
+#define TAPE_HH
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "json/number_scanner.hh"
+
+//
+// A parsed document is stored as a tape: one fixed size entry per value in
+// document order, followed by its children. Object members are stored as a
+// Key entry directly followed by the member's value.
+//
+//   {"a": [1, 2], "b": null}
+//
+//   0 Object  size 6
+//   1 Key     "a"
+//   2 Array   size 2  parent 0
+//   3 Integer 1       parent 2
+//   4 Integer 2       parent 2
+//   5 Key     "b"
+//   6 Null            parent 0
+//
+// The subtree size of every entry allows skipping over a value in constant
+// time; containers also know their number of members, and arrays can reach
+// any element in constant time. The text of strings and keys lives in a
+// separate arena (or in the borrowed source); entries only refer to it by
+// offset and length.
+//
+// With 32 bit indices an entry is 16 bytes.
+//
+
+namespace json::internal {
+
+enum class EntryType : uint8_t {
+  Object,
+  Array,
+  Number,
+  String,
+  Boolean,
+  Null,
+  Key,
+  // Numbers that are integers and fit 64 bits; Number holds a double.
+  Integer,
+  UInt64,
+};
+
+template <typename Index>
+class TapeEntry {
+  static_assert(std::is_unsigned_v<Index> && sizeof(Index) >= 4);
+
+  static constexpr Index TypeBits = 4;
+  static constexpr Index TypeMask = (Index{1} << TypeBits) - 1;
+  // Set on strings and keys whose text still contains escape sequences.
+  static constexpr Index EscapedFlag = Index{1} << TypeBits;
+  static constexpr Index SizeShift = TypeBits + 1;
+
+ public:
+  static constexpr Index MaxSize = std::numeric_limits<Index>::max() >>
+                                   SizeShift;
+
+  [[nodiscard]] static auto make(EntryType type, Index parent) -> TapeEntry {
+    TapeEntry entry{};
+    entry.parent_ = parent;
+    entry.size_and_type_ = static_cast<Index>(type);
+    return entry;
+  }
+
+  [[nodiscard]] static auto makeNumber(ScannedNumber number, Index parent)
+      -> TapeEntry {
+    auto entry = make(numberType(number.kind), parent);
+    std::memcpy(entry.payload_.data(), &number.bits, sizeof(number.bits));
+    return entry;
+  }
+
+  [[nodiscard]] static auto makeBoolean(bool value, Index parent)
+      -> TapeEntry {
+    auto entry = make(EntryType::Boolean, parent);
+    entry.payload_[0] = value ? 1 : 0;
+    return entry;
+  }
+
+  [[nodiscard]] static auto makeText(EntryType type, Index offset,
+                                     Index length, bool escaped, Index parent)
+      -> TapeEntry {
+    auto entry = make(type, parent);
+    entry.payload_ = {offset, length};
+    if (escaped) entry.size_and_type_ |= EscapedFlag;
+    return entry;
+  }
+
+  [[nodiscard]] auto type() const -> EntryType {
+    return static_cast<EntryType>(size_and_type_ & TypeMask);
+  }
+
+  [[nodiscard]] auto parent() const -> Index { return parent_; }
+
+  void setParent(Index parent) { parent_ = parent; }
+
+  // Number of entries following this one that belong to its subtree.
+  [[nodiscard]] auto size() const -> Index {
+    return size_and_type_ >> SizeShift;
+  }
+
+  void setSize(Index size) {
+    size_and_type_ = (size_and_type_ & (TypeMask | EscapedFlag)) |
+                     static_cast<Index>(size << SizeShift);
+  }
+
+  // Number, Integer and UInt64 entries.
+  [[nodiscard]] auto scannedNumber() const -> ScannedNumber {
+    ScannedNumber number;
+    std::memcpy(&number.bits, payload_.data(), sizeof(number.bits));
+    switch (type()) {
+      case EntryType::Integer:
+        number.kind = ScannedNumber::Kind::Integer;
+        break;
+      case EntryType::UInt64:
+        number.kind = ScannedNumber::Kind::UInt64;
+        break;
+      default:
+        break;
+    }
+    return number;
+  }
+
+  [[nodiscard]] auto isNumber() const -> bool {
+    const auto type = this->type();
+    return type == EntryType::Number || type == EntryType::Integer ||
+           type == EntryType::UInt64;
+  }
+
+  [[nodiscard]] auto boolean() const -> bool { return payload_[0] != 0; }
+
+  // Containers: number of members of an object, or of values in an array.
+  [[nodiscard]] auto count() const -> Index { return payload_[0]; }
+
+  void setCount(Index count) { payload_[0] = count; }
+
+  void addChild() { ++payload_[0]; }
+
+  void removeChild() { --payload_[0]; }
+
+  // Objects: offset of the object's key table plus one, or 0 if the object
+  // is not indexed (see json/key_index.hh). Arrays: offset of the array's
+  // element offsets in Tape::elements plus one, or 0 if every element is at
+  // a fixed distance.
+  [[nodiscard]] auto table() const -> Index { return payload_[1]; }
+
+  void setTable(Index offset) { payload_[1] = offset; }
+
+  [[nodiscard]] auto textOffset() const -> Index { return payload_[0]; }
+
+  void setTextOffset(Index offset) { payload_[0] = offset; }
+
+  [[nodiscard]] auto textLength() const -> Index { return payload_[1]; }
+
+  [[nodiscard]] auto escaped() const -> bool {
+    return (size_and_type_ & EscapedFlag) != 0;
+  }
+
+  auto operator==(const TapeEntry&) const -> bool = default;
+
+ private:
+  [[nodiscard]] static auto numberType(ScannedNumber::Kind kind)
+      -> EntryType {
+    switch (kind) {
+      case ScannedNumber::Kind::Integer:
+        return EntryType::Integer;
+      case ScannedNumber::Kind::UInt64:
+        return EntryType::UInt64;
+      case ScannedNumber::Kind::Double:
+        break;
+    }
+    return EntryType::Number;
+  }
+
+  // Number, Integer and UInt64: the bits of the value. Boolean: 0 or 1.
+  // String and Key: offset and length of the text. Object and Array: member
+  // count and key table.
+  std::array<Index, 2> payload_{};
+  Index parent_{};
+  Index size_and_type_{};
+};
+
+static_assert(sizeof(TapeEntry<uint32_t>) == 16);
+
+template <typename Index>
+struct Tape {
+  static constexpr auto Root = std::numeric_limits<Index>::max();
+
+  std::pmr::vector<TapeEntry<Index>> entries;
+  // Text of strings and keys, unless they are borrowed from the source.
+  std::pmr::string strings;
+  // Distance from an array entry to each of its elements, for arrays that
+  // contain containers. Arrays of scalars store their elements back to back
+  // and need no table.
+  std::pmr::vector<Index> elements;
+
+  Tape() = default;
+
+  // All three buffers allocate from `resource`. Moving a tape keeps its
+  // resource; assigning it to a tape with another resource copies it.
+  explicit Tape(std::pmr::memory_resource* resource)
+      : entries{resource}, strings{resource}, elements{resource} {}
+
+  [[nodiscard]] auto resource() const -> std::pmr::memory_resource* {
+    return entries.get_allocator().resource();
+  }
+
+  auto operator==(const Tape&) const -> bool = default;
+};
+
+// What a document reads of a tape: the buffers of its own Tape, or the
+// sections of a mapped cache file (see json/tape_cache.hh).
+template <typename Index>
+struct TapeView {
+  std::span<const TapeEntry<Index>> entries;
+  std::string_view strings;
+  std::span<const Index> elements;
+};
+
+}  // namespace json::internal
+
+#endif  // TAPE_HH
@@ -0,0 +1,243 @@
+#ifndef TAPE_BUILDER_HH
+#define TAPE_BUILDER_HH
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "json/character_utils.hh"
+#include "json/parse_stats.hh"
+#include "json/status.hh"
+#include "json/tape.hh"
+
+namespace json::internal {
+
+enum class StringStorage {
+  // Strings and keys are unescaped and copied into the tape's string arena.
+  Copy,
+  // Strings and keys refer to the source and are unescaped on access.
+  Borrow
+};
+
+// The EventParser handler that builds a document's tape.
+template <typename Index = uint32_t>
+class TapeBuilder {
+  using Entry = TapeEntry<Index>;
+  static constexpr auto Root = Tape<Index>::Root;
+
+  Tape<Index> tape_;
+  std::pmr::vector<Index> parents_;
+  StringStorage string_storage_;
+  const char* source_{};
+  bool has_escapes_{};
+  std::pmr::string unescaped_;
+
+ public:
+  // The builder's own buffers allocate from `resource`; the tape from the
+  // storage passed to reset().
+  explicit TapeBuilder(
+      StringStorage string_storage = StringStorage::Copy,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : tape_{resource},
+        parents_{{Root}, resource},
+        string_storage_{string_storage},
+        unescaped_{resource} {}
+
+  // Prepares the builder for the next document, building into `storage`.
+  // Neither the builder's stack nor the storage release their capacity.
+  void reset(Tape<Index>&& storage, StringStorage string_storage) {
+    // Constructed, not assigned, so that the tape keeps the memory resource
+    // of `storage`.
+    std::destroy_at(&tape_);
+    std::construct_at(&tape_, std::move(storage));
+    tape_.entries.clear();
+    tape_.strings.clear();
+    tape_.elements.clear();
+    parents_.clear();
+    parents_.push_back(Root);
+    string_storage_ = string_storage;
+    has_escapes_ = false;
+  }
+
+  // Borrowed text is addressed by its offset into the source.
+  [[nodiscard]] auto start(std::string_view json_source) -> bool {
+    source_ = json_source.data();
+    return string_storage_ == StringStorage::Copy ||
+           json_source.size() <= std::numeric_limits<Index>::max();
+  }
+
+  // Offsets and sizes were narrowed to Index while building.
+  [[nodiscard]] auto complete(Status status) const -> Status {
+    if (status != Status::Ok) return status;
+    if (tape_.entries.size() > Entry::MaxSize ||
+        tape_.strings.size() > std::numeric_limits<Index>::max())
+      return Status::DocumentTooLarge;
+    return Status::Ok;
+  }
+
+  // Makes room for `entries` more values and `string_bytes` more bytes of
+  // copied text.
+  void reserve(size_t entries, size_t string_bytes) {
+    tape_.entries.reserve(tape_.entries.size() + entries);
+    tape_.strings.reserve(tape_.strings.size() + string_bytes);
+  }
+
+  [[nodiscard]] auto tape() const -> const Tape<Index>& { return tape_; }
+
+  [[nodiscard]] auto takeTape() -> Tape<Index> { return std::move(tape_); }
+
+  // True if any borrowed string or key contains escape sequences.
+  [[nodiscard]] auto hasEscapes() const -> bool { return has_escapes_; }
+
+  void onObjectStart() { openContainer(EntryType::Object); }
+
+  void onArrayStart() { openContainer(EntryType::Array); }
+
+  void onObjectEnd() {
+    // A member name without a value can only be the last entry, when the
+    // input ended right after it.
+    if (tape_.entries.back().type() == EntryType::Key) {
+      tape_.entries.pop_back();
+      tape_.entries[parents_.back()].removeChild();
+    }
+    closeContainer();
+  }
+
+  void onArrayEnd() { closeContainer(); }
+
+  [[nodiscard]] auto onKey(std::string_view text) -> Status {
+    auto status = appendText(EntryType::Key, text);
+    if (status == Status::Ok) tape_.entries[parents_.back()].addChild();
+    return status;
+  }
+
+  [[nodiscard]] auto onString(std::string_view text) -> Status {
+    countValue();
+    return appendText(EntryType::String, text);
+  }
+
+  // Keys and strings given as they are, not as escaped JSON text. Always
+  // copied.
+  void addKey(std::string_view text) {
+    copyText(EntryType::Key, text);
+    tape_.entries[parents_.back()].addChild();
+  }
+
+  void addString(std::string_view text) {
+    countValue();
+    copyText(EntryType::String, text);
+  }
+
+  void onNumber(ScannedNumber value) {
+    countValue();
+    push(Entry::makeNumber(value, parents_.back()));
+  }
+
+  void onBoolean(bool value) {
+    countValue();
+    push(Entry::makeBoolean(value, parents_.back()));
+  }
+
+  void onNull() {
+    countValue();
+    push(Entry::make(EntryType::Null, parents_.back()));
+  }
+
+ private:
+  // All entries are added here, where growing the tape is counted.
+  void push(Entry entry) {
+    const GrowthCounter growth{tape_.entries};
+    tape_.entries.push_back(entry);
+  }
+
+  // Object members are counted by their names.
+  void countValue() {
+    const auto parent = parents_.back();
+    if (parent != Root && tape_.entries[parent].type() == EntryType::Array)
+      tape_.entries[parent].addChild();
+  }
+
+  void openContainer(EntryType type) {
+    countValue();
+    auto parent = parents_.back();
+    {
+      const GrowthCounter growth{parents_};
+      parents_.push_back(static_cast<Index>(tape_.entries.size()));
+    }
+    countDepth(parents_.size() - 1);
+    push(Entry::make(type, parent));
+  }
+
+  // Entries are stored in document order, so everything added since the
+  // container was opened belongs to it.
+  void closeContainer() {
+    const auto container = parents_.back();
+    auto& entry = tape_.entries[container];
+    entry.setSize(static_cast<Index>(tape_.entries.size() - container - 1));
+    parents_.pop_back();
+
+    // Elements of arrays that contain containers are not evenly spaced; the
+    // children are still hot in the cache, so record where each one starts.
+    if (entry.type() == EntryType::Array && entry.count() > 1 &&
+        entry.size() != entry.count()) {
+      entry.setTable(static_cast<Index>(tape_.elements.size() + 1));
+      for (Index offset = 1; offset <= entry.size();
+           offset += 1 + tape_.entries[container + offset].size()) {
+        const GrowthCounter growth{tape_.elements};
+        tape_.elements.push_back(offset);
+      }
+    }
+  }
+
+  [[nodiscard]] auto appendText(EntryType type, std::string_view text)
+      -> Status {
+    const auto escaped = text.find('\\') != std::string_view::npos;
+
+    if (string_storage_ == StringStorage::Borrow) {
+      // Borrowed text is unescaped on access, but invalid escapes are
+      // rejected now.
+      if (escaped) {
+        unescaped_.clear();
+        if (!unescape(text, unescaped_)) return Status::UnexpectedCharacter;
+        has_escapes_ = true;
+      }
+      push(Entry::makeText(type, static_cast<Index>(text.data() - source_),
+                           static_cast<Index>(text.size()), escaped,
+                           parents_.back()));
+      return Status::Ok;
+    }
+
+    if (!escaped) {
+      copyText(type, text);
+      return Status::Ok;
+    }
+    const auto offset = tape_.strings.size();
+    const GrowthCounter growth{tape_.strings};
+    if (!unescape(text, tape_.strings)) return Status::UnexpectedCharacter;
+    pushCopiedText(type, offset);
+    return Status::Ok;
+  }
+
+  void copyText(EntryType type, std::string_view text) {
+    const auto offset = tape_.strings.size();
+    const GrowthCounter growth{tape_.strings};
+    tape_.strings.append(text);
+    pushCopiedText(type, offset);
+  }
+
+  // The text appended to the string arena since `offset`.
+  void pushCopiedText(EntryType type, size_t offset) {
+    push(Entry::makeText(type, static_cast<Index>(offset),
+                         static_cast<Index>(tape_.strings.size() - offset),
+                         false, parents_.back()));
+  }
+};
+
+}  // namespace json::internal
+
+#endif  // TAPE_BUILDER_HH
@@ -0,0 +1,329 @@
+#ifndef TAPE_CACHE_HH
+#define TAPE_CACHE_HH
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/key_index.hh"
+#include "json/mapped_file.hh"
+#include "json/status.hh"
+#include "json/tape.hh"
+
+//
+// Cache files hold a parsed document's tape as it is in memory, so that
+// loading one maps the file and uses it in place instead of parsing:
+//
+//   auto status = json::writeCache(*json, "config.tape");
+//   ...
+//   auto json = json::loadCache("config.tape");
+//
+// A file starts with a CacheHeader, followed by the tape's entries, the text
+// of its strings and names, its element table, and its key index tables;
+// each section starts at a multiple of 64 bytes. Entries refer to text and
+// to each other by offset, so nothing needs to be fixed up after mapping.
+//
+// Values are stored in the byte order of the machine that wrote the file,
+// and with the entry layout of the index type. Files written elsewhere, by
+// another version, or for another index type are rejected as InvalidCache.
+// A checksum over the whole file detects truncated or damaged files, but
+// files must come from a trusted writer: the tape itself is not validated.
+//
+
+namespace json {
+
+namespace internal {
+
+struct CacheHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  // CacheByteOrder as written by the machine that wrote the file.
+  uint32_t byte_order;
+  uint32_t index_size;
+  uint32_t entry_size;
+  uint64_t entries;
+  uint64_t string_bytes;
+  uint64_t elements;
+  uint64_t key_slots;
+  // Of the file, with this field set to 0; see TapeCache::checksum().
+  uint64_t checksum;
+};
+
+static_assert(sizeof(CacheHeader) == 64);
+
+inline constexpr std::array<char, 8> CacheMagic{'J', 'S', 'O', 'N',
+                                                'T', 'A', 'P', 'E'};
+// Changes whenever the layout of the file or of TapeEntry does.
+inline constexpr uint32_t CacheVersion = 1;
+inline constexpr uint32_t CacheByteOrder = 0x01020304;
+inline constexpr size_t CacheAlignment = 64;
+
+// A 64 bit hash of `bytes`, continuing from `seed`, for detecting damaged
+// files; it is not meant to withstand deliberate changes. Four lanes of
+// 8 byte words keep it as fast as memory can deliver the file.
+[[nodiscard]] inline auto cacheChecksum(std::string_view bytes,
+                                        uint64_t seed = 0) -> uint64_t {
+  constexpr uint64_t Prime1 = 0x9E3779B185EBCA87;
+  constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4F;
+  const auto round = [](uint64_t hash, uint64_t word) {
+    return std::rotl(hash + word * Prime2, 31) * Prime1;
+  };
+  const auto word = [&](size_t pos) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes.data() + pos,
+                std::min(sizeof(value), bytes.size() - pos));
+    return value;
+  };
+
+  std::array<uint64_t, 4> lanes{seed + Prime1 + Prime2, seed + Prime2, seed,
+                                seed - Prime1};
+  size_t pos = 0;
+  for (; bytes.size() - pos >= 32; pos += 32) {
+    for (size_t lane = 0; lane != lanes.size(); ++lane)
+      lanes[lane] = round(lanes[lane], word(pos + lane * 8));
+  }
+
+  uint64_t hash = bytes.size();
+  for (const auto lane : lanes) hash = round(hash ^ lane, lane);
+  for (; pos < bytes.size(); pos += 8) hash = round(hash, word(pos));
+
+  hash ^= hash >> 33;
+  hash *= Prime2;
+  hash ^= hash >> 29;
+  return hash;
+}
+
+// Where the sections of a cache file start, and where it ends.
+struct CacheLayout {
+  size_t entries;
+  size_t strings;
+  size_t elements;
+  size_t key_slots;
+  size_t end;
+};
+
+// Reads and writes cache files for documents with tape indices of type
+// `Index`.
+template <typename Index>
+class TapeCache {
+  using Json = BasicJson<Index>;
+  using Entry = TapeEntry<Index>;
+  using Slot = typename KeyIndex<Index>::Slot;
+
+  static_assert(std::is_trivially_copyable_v<Entry> &&
+                std::is_trivially_copyable_v<Slot>);
+
+ public:
+  // The contents of a cache file for `json`.
+  [[nodiscard]] static auto write(const Json& json, std::string& out)
+      -> Status {
+    auto entries = json.entries();
+    auto strings = json.strings();
+
+    // Borrowed text is part of the source, not of the document; it goes
+    // into an arena of its own, unescaped.
+    std::vector<Entry> copied;
+    std::string arena;
+    if (json.source_ != nullptr) {
+      copied.assign(entries.begin(), entries.end());
+      for (auto& entry : copied) {
+        if (entry.type() != EntryType::String &&
+            entry.type() != EntryType::Key)
+          continue;
+        const auto text = json.text(entry);
+        if (arena.size() + text.size() > std::numeric_limits<Index>::max())
+          return Status::DocumentTooLarge;
+        entry = Entry::makeText(
+            entry.type(), static_cast<Index>(arena.size()),
+            static_cast<Index>(text.size()), false, entry.parent());
+        arena.append(text);
+      }
+      entries = copied;
+      strings = arena;
+    }
+
+    const auto elements = json.elements();
+    const auto slots = json.key_index_.slots();
+    CacheHeader header{.magic = CacheMagic,
+                       .version = CacheVersion,
+                       .byte_order = CacheByteOrder,
+                       .index_size = sizeof(Index),
+                       .entry_size = sizeof(Entry),
+                       .entries = entries.size(),
+                       .string_bytes = strings.size(),
+                       .elements = elements.size(),
+                       .key_slots = slots.size(),
+                       .checksum = 0};
+    const auto layout = layoutFor(header);
+
+    out.assign(layout.end, '\0');
+    copySection(std::as_bytes(entries), layout.entries, out);
+    copySection(std::as_bytes(std::span{strings}), layout.strings, out);
+    copySection(std::as_bytes(elements), layout.elements, out);
+    copySection(std::as_bytes(slots), layout.key_slots, out);
+
+    header.checksum =
+        checksum(header, std::string_view{out}.substr(sizeof(header)));
+    std::memcpy(out.data(), &header, sizeof(header));
+    return Status::Ok;
+  }
+
+  // A document reading its tape from `mapping`, which it keeps.
+  [[nodiscard]] static auto load(MappedFile&& mapping) -> StatusOr<Json> {
+    const auto bytes = mapping.contents();
+    CacheHeader header{};
+    if (bytes.size() < sizeof(header)) return Status::InvalidCache;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != CacheMagic || header.version != CacheVersion ||
+        header.byte_order != CacheByteOrder ||
+        header.index_size != sizeof(Index) ||
+        header.entry_size != sizeof(Entry))
+      return Status::InvalidCache;
+
+    const auto layout = checkedLayout(header, bytes.size());
+    if (!layout || layout->end != bytes.size()) return Status::CorruptCache;
+    const auto expected = std::exchange(header.checksum, 0);
+    if (checksum(header, bytes.substr(sizeof(header))) != expected)
+      return Status::CorruptCache;
+
+    Json json;
+    json.view_ = {
+        section<Entry>(bytes, layout->entries, header.entries),
+        bytes.substr(layout->strings, header.string_bytes),
+        section<Index>(bytes, layout->elements, header.elements)};
+    json.key_index_.load(
+        section<Slot>(bytes, layout->key_slots, header.key_slots));
+    json.mapping_ = std::move(mapping);
+    return json;
+  }
+
+ private:
+  // Of the header, with its checksum set to 0, and the sections after it.
+  [[nodiscard]] static auto checksum(const CacheHeader& header,
+                                     std::string_view sections) -> uint64_t {
+    const std::string_view header_bytes{
+        reinterpret_cast<const char*>(&header),  // NOLINT
+        sizeof(header)};
+    return cacheChecksum(sections, cacheChecksum(header_bytes));
+  }
+
+  [[nodiscard]] static constexpr auto align(size_t offset) -> size_t {
+    return (offset + CacheAlignment - 1) / CacheAlignment * CacheAlignment;
+  }
+
+  [[nodiscard]] static auto layoutFor(const CacheHeader& header)
+      -> CacheLayout {
+    CacheLayout layout{};
+    layout.entries = align(sizeof(CacheHeader));
+    layout.strings = align(layout.entries + header.entries * sizeof(Entry));
+    layout.elements = align(layout.strings + header.string_bytes);
+    layout.key_slots =
+        align(layout.elements + header.elements * sizeof(Index));
+    layout.end = layout.key_slots + header.key_slots * sizeof(Slot);
+    return layout;
+  }
+
+  // The layout, unless the counts in `header` cannot belong to a file of
+  // `size` bytes and a document of this index type.
+  [[nodiscard]] static auto checkedLayout(const CacheHeader& header,
+                                          size_t size)
+      -> std::optional<CacheLayout> {
+    if (header.entries > Entry::MaxSize ||
+        header.string_bytes > std::numeric_limits<Index>::max() ||
+        header.elements > size / sizeof(Index) ||
+        header.key_slots > size / sizeof(Slot))
+      return std::nullopt;
+    return layoutFor(header);
+  }
+
+  static void copySection(std::span<const std::byte> section, size_t offset,
+                          std::string& out) {
+    if (!section.empty())
+      std::memcpy(out.data() + offset, section.data(), section.size());
+  }
+
+  // Sections start at multiples of CacheAlignment in a page aligned mapping,
+  // so they are aligned for their type.
+  template <typename T>
+  [[nodiscard]] static auto section(std::string_view bytes, size_t offset,
+                                    size_t count) -> std::span<const T> {
+    return {reinterpret_cast<const T*>(bytes.data() + offset),  // NOLINT
+            count};
+  }
+};
+
+// Writes `contents` to a temporary file next to `path` and renames it, so
+// that readers see either the old file or the complete new one. mkstemp()
+// gives every writer a file of its own, also within one process.
+[[nodiscard]] inline auto replaceFile(const std::filesystem::path& path,
+                                      std::string_view contents) -> Status {
+  std::string temporary = path.native() + ".XXXXXX";
+  const int fd = ::mkstemp(temporary.data());
+  if (fd < 0) return Status::CannotWriteFile;
+
+  // mkstemp() creates the file readable by its owner only.
+  auto written = ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0;
+  for (size_t pos = 0; written && pos != contents.size();) {
+    const auto count =
+        ::write(fd, contents.data() + pos, contents.size() - pos);
+    if (count < 0 && errno == EINTR) continue;
+    written = count > 0;
+    if (written) pos += static_cast<size_t>(count);
+  }
+  written = ::close(fd) == 0 && written;
+
+  std::error_code error;
+  if (written) std::filesystem::rename(temporary, path, error);
+  if (!written || error) {
+    std::filesystem::remove(temporary, error);
+    return Status::CannotWriteFile;
+  }
+  return Status::Ok;
+}
+
+}  // namespace internal
+
+// Writes `json` to a cache file at `path`, replacing any file there. Key
+// index tables are written along, so loaded documents have the same ones.
+template <typename Index>
+[[nodiscard]] auto writeCache(const BasicJson<Index>& json,
+                              const std::filesystem::path& path) -> Status {
+  std::string contents;
+  auto status = internal::TapeCache<Index>::write(json, contents);
+  if (status != Status::Ok) return status;
+  return internal::replaceFile(path, contents);
+}
+
+// Maps the cache file at `path` and returns the document in it, after
+// checking its header and checksum. The document reads the mapping in
+// place for as long as it lives.
+template <typename Index = uint32_t>
+[[nodiscard]] auto loadCache(const std::filesystem::path& path)
+    -> StatusOr<BasicJson<Index>> {
+  auto mapping = internal::MappedFile::open(path);
+  if (!mapping) return mapping.status();
+  return internal::TapeCache<Index>::load(std::move(*mapping));
+}
+
+}  // namespace json
+
+#endif  // TAPE_CACHE_HH
@@ -0,0 +1,127 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "json/json.hh"
+#include "json/serializer.hh"
+#include "json/tape_cache.hh"
+#include "testrunner/testrunner.h"
+
+namespace {
+
+constexpr std::string_view Source =
+    R"({"name": "tape \"cache\"", "ids": [1, -2, 18446744073709551615],
+        "nested": [{"a": 0.5}, [true, null], "x"], "": {}})";
+
+auto cachePath(std::string_view name) -> std::filesystem::path {
+  return std::filesystem::temp_directory_path() / name;
+}
+
+auto readFile(const std::filesystem::path& path) -> std::string {
+  std::ifstream file{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+void writeFile(const std::filesystem::path& path, std::string_view contents) {
+  std::ofstream{path, std::ios::binary} << contents;
+}
+
+}  // namespace
+
+TEST(TapeCache_LoadsWhatWasWritten) {
+  const auto path = cachePath("json_tape_cache_test.tape");
+  for (const auto borrow : {false, true}) {
+    for (const auto threshold : {0U, 1U}) {
+      const auto json = json::Json::parse(
+          Source, {.borrow_source = borrow, .key_index_threshold = threshold});
+      ASSERT_TRUE(json);
+      ASSERT_EQ(json::writeCache(*json, path), json::Status::Ok);
+
+      const auto loaded = json::loadCache(path);
+      ASSERT_TRUE(loaded);
+      EXPECT_EQ(json::serialize(*loaded), json::serialize(*json));
+      EXPECT_EQ(*(*loaded)["name"].string(), "tape \"cache\"");
+      EXPECT_EQ((*loaded)["ids"][2].uint64(), uint64_t{18446744073709551615U});
+      EXPECT_EQ(*(*loaded)["nested"][1][0].boolean(), true);
+      EXPECT_EQ((*loaded)["nested"][2].string(), std::string_view{"x"});
+      EXPECT_TRUE((*loaded)["missing"] == loaded->end());
+
+      // A loaded document writes the same file again.
+      const auto written = readFile(path);
+      ASSERT_EQ(json::writeCache(*loaded, path), json::Status::Ok);
+      EXPECT_TRUE(readFile(path) == written);
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(TapeCache_LoadedDocumentsCanBeParsedInto) {
+  const auto path = cachePath("json_tape_cache_reuse.tape");
+  ASSERT_EQ(json::writeCache(*json::Json::parse(Source), path),
+            json::Status::Ok);
+  auto loaded = json::loadCache(path);
+  ASSERT_TRUE(loaded);
+  std::filesystem::remove(path);
+
+  ASSERT_EQ(json::Json::parseInto(*loaded, R"({"other": [2]})"),
+            json::Status::Ok);
+  EXPECT_EQ(*(*loaded)["other"][0].number(), 2);
+  EXPECT_TRUE((*loaded)["name"] == loaded->end());
+}
+
+TEST(TapeCache_RejectsOtherAndDamagedFiles) {
+  const auto path = cachePath("json_tape_cache_damaged.tape");
+  EXPECT_EQ(json::loadCache(path).status(), json::Status::CannotReadFile);
+
+  writeFile(path, Source);
+  EXPECT_EQ(json::loadCache(path).status(), json::Status::InvalidCache);
+
+  ASSERT_EQ(json::writeCache(*json::Json::parse(Source), path),
+            json::Status::Ok);
+  const auto contents = readFile(path);
+  EXPECT_EQ(json::loadCache<uint64_t>(path).status(),
+            json::Status::InvalidCache);
+
+  auto other_version = contents;
+  ++other_version[8];
+  writeFile(path, other_version);
+  EXPECT_EQ(json::loadCache(path).status(), json::Status::InvalidCache);
+
+  writeFile(path, contents.substr(0, contents.size() - 1));
+  EXPECT_EQ(json::loadCache(path).status(), json::Status::CorruptCache);
+
+  // A flipped bit in the text of "name".
+  auto damaged = contents;
+  damaged[damaged.find("tape")] ^= 0x20;
+  writeFile(path, damaged);
+  EXPECT_EQ(json::loadCache(path).status(), json::Status::CorruptCache);
+
+  std::filesystem::remove(path);
+}
+
+TEST(TapeCache_ConcurrentWritersReplaceWholeFiles) {
+  const auto path = cachePath("json_tape_cache_concurrent.tape");
+  const auto json = json::Json::parse(Source);
+  ASSERT_TRUE(json);
+
+  std::vector<std::thread> writers;
+  std::vector<json::Status> statuses(4, json::Status::Ok);
+  for (auto& status : statuses) {
+    writers.emplace_back([&] {
+      for (int write = 0; write != 20 && status == json::Status::Ok; ++write)
+        status = json::writeCache(*json, path);
+    });
+  }
+  for (auto& writer : writers) writer.join();
+  for (const auto status : statuses) EXPECT_EQ(status, json::Status::Ok);
+
+  const auto loaded = json::loadCache(path);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(json::serialize(*loaded), json::serialize(*json));
+  std::filesystem::remove(path);
+}
@@ -3,6 +3,7 @@
 
 #include <string_view>
 
+#include "json/number_scanner.hh"
 #include "utility/one_of.hh"
 
 namespace json {
@@ -36,6 +37,8 @@ struct Token {
 
   Type type;
   std::string_view value;
+  // Numbers are converted while they are scanned.
+  internal::ScannedNumber number{};
 
   [[nodiscard]] constexpr auto isDataType() const -> bool {
     return type == one_of(Type::String, Type::Number);
@@ -1,37 +1,65 @@
 #ifndef TOKENIZER_HH
 #define TOKENIZER_HH
 
-#include <array>
-#include <functional>
 #include <string_view>
 
 #include "json/character_utils.hh"
+#include "json/number_scanner.hh"
 #include "json/status.hh"
 #include "json/token.hh"
-#include "utility/flat_map.hh"
 
 namespace json::internal {
 
 class Tokenizer {
  public:
   static auto parse(std::string_view& json) -> StatusOr<Token> {
-    using Parser = std::function<StatusOr<Token>(std::string_view&)>;
-    static const std::array<Parser, 6> Parsers{
-        Tokenizer::skipWhitespace,     Tokenizer::parseStructuralTokens,
-        Tokenizer::parseLiteralTokens, Tokenizer::parseNumberToken,
-        Tokenizer::parseStringToken,   Tokenizer::abortIfNotEmpty};
-
-    for (const auto& parser : Parsers) {
-      auto maybe_token = parser(json);
-      if (maybe_token) return *maybe_token;
-      if (maybe_token.status() != Status::Ok) return maybe_token.status();
+    skipWhitespace(json);
+    if (json.empty()) return Status::Ok;
+
+    switch (classify(json[0])) {
+      //" The six structural tokens:
+      case CharClass::LeftSquareBracket:
+        return parseStructuralToken(json, Token::Type::LeftSquareBracket);
+      case CharClass::LeftCurlyBracket:
+        return parseStructuralToken(json, Token::Type::LeftCurlyBracket);
+      case CharClass::RightSquareBracket:
+        return parseStructuralToken(json, Token::Type::RightSquareBracket);
+      case CharClass::RightCurlyBracket:
+        return parseStructuralToken(json, Token::Type::RightCurlyBracket);
+      case CharClass::Colon:
+        return parseStructuralToken(json, Token::Type::Colon);
+      case CharClass::Comma:
+        return parseStructuralToken(json, Token::Type::Comma);
+
+      //"
+      //" These are the three literal name tokens:
+      //"   true   U+0074 U+0072 U+0075 U+0065
+      //"   false  U+0066 U+0061 U+006C U+0073 U+0065
+      //"   null   U+006E U+0075 U+006C U+006C
+      //"
+      case CharClass::LiteralTrue:
+        return parseLiteralToken(json, "true", Token::Type::True);
+      case CharClass::LiteralFalse:
+        return parseLiteralToken(json, "false", Token::Type::False);
+      case CharClass::LiteralNull:
+        return parseLiteralToken(json, "null", Token::Type::Null);
+
+      case CharClass::Number:
+        return parseNumberToken(json);
+
+      case CharClass::Quote:
+        return parseStringToken(json);
+
+      case CharClass::Whitespace:
+      case CharClass::Invalid:
+        break;
     }
 
-    return Status::Ok;
+    return Status::UnexpectedCharacter;
   }
 
  private:
-  static auto skipWhitespace(std::string_view& json) -> StatusOr<Token> {
+  static void skipWhitespace(std::string_view& json) {
     //"
     //" Insignificant whitespace is allowed before or after any token.
     //" Whitespace is any sequence of one or more of the following code points:
@@ -39,67 +67,46 @@ class Tokenizer {
     //" (U+000D), and space (U+0020). Whitespace is not allowed within any
     //" token, except that space is allowed in strings.
     //"
-    json.remove_prefix(
-        std::min(json.find_first_not_of("\t\n\r "), json.size()));
-    return Status::Ok;
+    size_t idx = 0;
+    while (idx != json.size() && isWhitespace(json[idx])) ++idx;
+    json.remove_prefix(idx);
   }
 
-  [[nodiscard]] static auto parseStructuralTokens(std::string_view& json)
+  [[nodiscard]] static auto parseStructuralToken(std::string_view& json,
+                                                 Token::Type type)
       -> StatusOr<Token> {
-    //" The six structural tokens:
-    static constexpr auto StructuralTokens =
-        FlatMap<char, Token::Type, 6>{{'[', Token::Type::LeftSquareBracket},
-                                      {'{', Token::Type::LeftCurlyBracket},
-                                      {']', Token::Type::RightSquareBracket},
-                                      {'}', Token::Type::RightCurlyBracket},
-                                      {':', Token::Type::Colon},
-                                      {',', Token::Type::Comma}};
-
-    if (json.empty() || !StructuralTokens.contains(json[0])) return Status::Ok;
-    auto token = Token{StructuralTokens[json[0]], ""};
     json.remove_prefix(1);
-    return token;
+    return Token{type, ""};
   }
 
-  [[nodiscard]] static auto parseLiteralTokens(std::string_view& json)
+  [[nodiscard]] static auto parseLiteralToken(std::string_view& json,
+                                              std::string_view literal,
+                                              Token::Type type)
       -> StatusOr<Token> {
-    //"
-    //" These are the three literal name tokens:
-    //"   true   U+0074 U+0072 U+0075 U+0065
-    //"   false  U+0066 U+0061 U+006C U+0073 U+0065
-    //"   null   U+006E U+0075 U+006C U+006C
-    //"
-
     // Note: The code points given indicate these literal tokens must be
-    // lowercase.
-    static constexpr auto LiteralTokens =
-        FlatMap<std::string_view, Token::Type, 3>{{"true", Token::Type::True},
-                                                  {"false", Token::Type::False},
-                                                  {"null", Token::Type::Null}};
-    auto starts_with = json::internal::extractLowerCaseAlpha(json);
-    if (starts_with.empty() || !LiteralTokens.contains(starts_with))
-      return Status::Ok;
-    json.remove_prefix(starts_with.size());
-    return Token{LiteralTokens[starts_with], ""};
+    // lowercase. A literal followed by further lowercase letters ("nullify")
+    // is a different word, not a literal.
+    if (!json.starts_with(literal)) return Status::UnexpectedCharacter;
+    if (json.size() > literal.size() && isLowerCaseAlpha(json[literal.size()]))
+      return Status::UnexpectedCharacter;
+
+    json.remove_prefix(literal.size());
+    return Token{type, ""};
   }
 
   [[nodiscard]] static auto parseNumberToken(std::string_view& json)
       -> StatusOr<Token> {
-    if (json.empty() || (json[0] != '-' && !json::internal::isDigit(json[0])))
-      return Status::Ok;
+    ScannedNumber number;
+    const auto length = scanNumber(json, number);
+    if (length == 0) return Status::UnexpectedCharacter;
 
-    auto number_slice = internal::extractNumber(json);
-    if (number_slice.empty()) return Status::UnexpectedCharacter;
-
-    auto token = Token{Token::Type::Number, number_slice};
-    json.remove_prefix(number_slice.length());
+    auto token = Token{Token::Type::Number, json.substr(0, length), number};
+    json.remove_prefix(length);
     return token;
   }
 
   [[nodiscard]] static auto parseStringToken(std::string_view& json)
       -> StatusOr<Token> {
-    if (json.empty() || json[0] != '"') return Status::Ok;
-
     //"
     //" 9 String
     //"
@@ -113,7 +120,12 @@ class Tokenizer {
     // TODO(ae): Escaped characters ...
     // TODO(ae): Four digit hex codes
 
+    // Escape sequences are kept as is for now, but an escaped quotation mark
+    // must not end the string.
     auto closing_quote = json.find('"', 1);
+    while (closing_quote != std::string_view::npos &&
+           isEscaped(json, closing_quote))
+      closing_quote = json.find('"', closing_quote + 1);
     if (closing_quote == std::string_view::npos)
       return Status::UnexpectedCharacter;
 
@@ -121,14 +133,8 @@ class Tokenizer {
     json.remove_prefix(closing_quote + 1);
     return token;
   }
-
-  [[nodiscard]] static auto abortIfNotEmpty(std::string_view& json)
-      -> StatusOr<Token> {
-    skipWhitespace(json);
-    return json.empty() ? Status::Ok : Status::UnexpectedCharacter;
-  }
 };
 
 }  // namespace json::internal
 
-#endif  // TOKENIZER_HH
\ No newline at end of file
+#endif  // TOKENIZER_HH
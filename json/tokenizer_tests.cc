@@ -0,0 +1,69 @@
+#include <string_view>
+
+#include "json/tokenizer.hh"
+#include "testrunner/testrunner.h"
+
+using json::Token;
+using json::internal::Tokenizer;
+
+TEST(Tokenizer_SkipsWhitespaceOnlyInput) {
+  std::string_view source = " \t\r\n ";
+  auto token = Tokenizer::parse(source);
+  ASSERT_FALSE(token);
+  EXPECT_EQ(token.status(), json::Status::Ok);
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(Tokenizer_ParsesStructuralTokens) {
+  std::string_view source = "[ { ] } : ,";
+  for (auto type : {Token::Type::LeftSquareBracket,
+                    Token::Type::LeftCurlyBracket,
+                    Token::Type::RightSquareBracket,
+                    Token::Type::RightCurlyBracket, Token::Type::Colon,
+                    Token::Type::Comma}) {
+    auto token = Tokenizer::parse(source);
+    ASSERT_TRUE(token);
+    EXPECT_TRUE(token->type == type);
+  }
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(Tokenizer_ParsesLiterals) {
+  std::string_view source = "true false null";
+  for (auto type : {Token::Type::True, Token::Type::False, Token::Type::Null}) {
+    auto token = Tokenizer::parse(source);
+    ASSERT_TRUE(token);
+    EXPECT_TRUE(token->type == type);
+  }
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(Tokenizer_RejectsMisspelledLiterals) {
+  for (std::string_view source : {"tru", "nul", "falsey", "True", "nullx"}) {
+    auto token = Tokenizer::parse(source);
+    ASSERT_FALSE(token);
+    EXPECT_EQ(token.status(), json::Status::UnexpectedCharacter);
+  }
+}
+
+TEST(Tokenizer_ParsesNumbersAndStrings) {
+  std::string_view source = R"(-12.5e3 "Hello")";
+
+  auto number = Tokenizer::parse(source);
+  ASSERT_TRUE(number);
+  EXPECT_TRUE(number->type == Token::Type::Number);
+  EXPECT_EQ(number->value, "-12.5e3");
+
+  auto string = Tokenizer::parse(source);
+  ASSERT_TRUE(string);
+  EXPECT_TRUE(string->type == Token::Type::String);
+  EXPECT_EQ(string->value, "Hello");
+}
+
+TEST(Tokenizer_RejectsUnexpectedCharacters) {
+  for (std::string_view source : {"@", "\"unterminated", "-", "+1"}) {
+    auto token = Tokenizer::parse(source);
+    ASSERT_FALSE(token);
+    EXPECT_EQ(token.status(), json::Status::UnexpectedCharacter);
+  }
+}
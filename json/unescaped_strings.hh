@@ -0,0 +1,57 @@
+#ifndef UNESCAPED_STRINGS_HH
+#define UNESCAPED_STRINGS_HH
+
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "json/character_utils.hh"
+
+namespace json::internal {
+
+// Documents keep strings in their escaped source form. The decoded text of
+// a string is produced on first access and kept here, keyed by the string's
+// position in the source, for as long as the document lives.
+class UnescapedStrings {
+ public:
+  explicit UnescapedStrings(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : strings_{resource} {}
+
+  [[nodiscard]] auto lookup(std::string_view escaped) -> std::string_view {
+    const std::lock_guard lock{mutex_};
+    auto [it, inserted] = strings_.try_emplace(escaped.data());
+    // The parser has already validated every escape sequence.
+    if (inserted) (void)unescape(escaped, it->second);
+    return it->second;
+  }
+
+  // Like lookup(), for text whose escape sequences were not validated yet.
+  // Invalid text is not kept.
+  [[nodiscard]] auto decode(std::string_view escaped)
+      -> std::optional<std::string_view> {
+    const std::lock_guard lock{mutex_};
+    auto [it, inserted] = strings_.try_emplace(escaped.data());
+    if (inserted && !unescape(escaped, it->second)) {
+      strings_.erase(it);
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void clear() {
+    const std::lock_guard lock{mutex_};
+    strings_.clear();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::pmr::unordered_map<const char*, std::pmr::string> strings_;
+};
+
+}  // namespace json::internal
+
+#endif  // UNESCAPED_STRINGS_HH
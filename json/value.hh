@@ -1,7 +1,8 @@
 #ifndef VALUE_HH
 #define VALUE_HH
 
-#include <string>
+#include <cstdint>
+#include <string_view>
 #include <variant>
 
 #include "utility/overloaded_helper.hh"
@@ -14,25 +15,48 @@ namespace json {
 //" A JSON value can be an object, array, number, string, true, false, or null.
 //"
 
-struct Object {};
+struct Object {
+  auto operator==(const Object&) const -> bool = default;
+};
 
-struct Array {};
+struct Array {
+  auto operator==(const Array&) const -> bool = default;
+};
 
 struct Number {
   double value{};
+  auto operator==(const Number&) const -> bool = default;
+};
+
+// Integral numbers are kept exact if they fit 64 bits: as Integer, or as
+// UInt64 above the range of int64_t.
+struct Integer {
+  int64_t value{};
+  auto operator==(const Integer&) const -> bool = default;
 };
 
+struct UInt64 {
+  uint64_t value{};
+  auto operator==(const UInt64&) const -> bool = default;
+};
+
+// Refers to the text held (or borrowed) by the document the value came from.
 struct String {
-  std::string value;
+  std::string_view value;
+  auto operator==(const String&) const -> bool = default;
 };
 
 struct Boolean {
   bool value{false};
+  auto operator==(const Boolean&) const -> bool = default;
 };
 
-struct Null {};
+struct Null {
+  auto operator==(const Null&) const -> bool = default;
+};
 
-using Value = std::variant<Object, Array, Number, String, Boolean, Null>;
+using Value = std::variant<Object, Array, Number, Integer, UInt64, String,
+                           Boolean, Null>;
 
 }  // namespace json
 
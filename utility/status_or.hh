@@ -1,6 +1,8 @@
 #ifndef STATUS_OR_HH
 #define STATUS_OR_HH
 
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 template <typename StatusType, typename ValueType>
@@ -25,13 +27,64 @@ class StatusOrBase {
   [[nodiscard]] StatusOrBase(ValueType&& value)
       : has_value_{true}, data_{std::move(value)} {}
 
-  ~StatusOrBase() {
-    if (has_value_) data_.~ValueType();
+  StatusOrBase(const StatusOrBase& other)
+    requires std::is_copy_constructible_v<ValueType>
+      : has_value_{other.has_value_} {
+    if (has_value_)
+      std::construct_at(&data_, other.data_);
+    else
+      status_ = other.status_;
   }
 
+  StatusOrBase(StatusOrBase&& other) noexcept(
+      std::is_nothrow_move_constructible_v<ValueType>)
+      : has_value_{other.has_value_} {
+    if (has_value_)
+      std::construct_at(&data_, std::move(other.data_));
+    else
+      status_ = other.status_;
+  }
+
+  // The copy is made before anything changes, so a throwing copy leaves
+  // *this as it was.
+  auto operator=(const StatusOrBase& other) -> StatusOrBase&
+    requires std::is_copy_constructible_v<ValueType>
+  {
+    if (this != &other) *this = StatusOrBase{other};
+    return *this;
+  }
+
+  auto operator=(StatusOrBase&& other) noexcept(
+      std::is_nothrow_move_constructible_v<ValueType> &&
+      std::is_nothrow_move_assignable_v<ValueType>) -> StatusOrBase& {
+    if (this == &other) return *this;
+    if constexpr (std::is_move_assignable_v<ValueType>) {
+      if (has_value_ && other.has_value_) {
+        data_ = std::move(other.data_);
+        return *this;
+      }
+    }
+    reset();
+    if (other.has_value_) {
+      // Holds the value only once it is constructed. If the constructor
+      // throws, *this is left without a value, and nothing is destroyed
+      // twice.
+      std::construct_at(&data_, std::move(other.data_));
+      has_value_ = true;
+    } else {
+      status_ = other.status_;
+    }
+    return *this;
+  }
+
+  ~StatusOrBase() { reset(); }
+
   [[nodiscard]] explicit operator bool() const { return has_value_; }
 
-  [[nodiscard]] auto status() const -> StatusType { return status_; }
+  // A value-initialized status (i.e. Ok) if there is a value.
+  [[nodiscard]] auto status() const -> StatusType {
+    return has_value_ ? StatusType{} : status_;
+  }
 
   [[nodiscard]] auto operator*() -> ValueType& { return data_; }
 
@@ -40,6 +93,13 @@ class StatusOrBase {
   [[nodiscard]] auto operator->() -> ValueType* { return &data_; }
 
   [[nodiscard]] auto operator->() const -> const ValueType* { return &data_; }
+
+ private:
+  // Destroys the value, if any.
+  void reset() {
+    if (has_value_) std::destroy_at(&data_);
+    has_value_ = false;
+  }
 };
 
 #endif  // STATUS_OR_HH